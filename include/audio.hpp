@@ -2,6 +2,14 @@
 //                                                                                                                                       //
 // Provides an interface for playing sound effects and songs.                                                                            //
 //                                                                                                                                       //
+// Sound effects aren't played immediately: requests are queued and dispatched once per tick, with requests of the same sound effect     //
+// merged into one (their volumes are added up to a limit, and their pans and pitches are blended by volume). This keeps large numbers   //
+// of simultaneous bounces from flooding the audio device.                                                                               //
+//                                                                                                                                       //
+// Sound effects are played on a fixed pool of preallocated voices. When every voice is busy, the oldest voice playing the least         //
+// important sound is stolen, but never for a less important sound, so cues like being hit, gaining a life or the game ending are never  //
+// cut off by bounces.                                                                                                                   //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
@@ -31,6 +39,11 @@ enum class sound {
 	COUNT
 };
 
+// Number of voices sound effects are played on.
+inline constexpr usize SOUND_VOICE_COUNT{32};
+// Maximum volume of merged sound effect requests relative to the loudest one.
+inline constexpr float MAX_MERGED_VOLUME_GAIN{1.5f};
+
 // Timestamp to skip the initial portion of the menu song when returning from other states.
 inline constexpr tr::fsecs SKIP_MENU_SONG_INTRO_TIMESTAMP{103769 / 44100.0f};
 
@@ -46,8 +59,10 @@ class audio {
 	// Sets the audio volume.
 	void set_volume(float sfx_volume, float music_volume);
 
-	// Plays a sound effect.
+	// Queues a sound effect to be played.
 	void play_sound(sound sound, float volume, float pan, float pitch = 1);
+	// Plays the sound effects queued since the last call.
+	void dispatch_queued_sounds();
 	// Plays a song.
 	void play_song(std::string_view name, tr::fsecs fade_in);
 	// Plays a song starting at an offset.
@@ -62,8 +77,35 @@ class audio {
 	void fade_song_out(tr::fsecs time);
 
   private:
+	// Requests of a sound effect queued since the last dispatch, merged together.
+	struct queued_sound {
+		// The number of merged requests.
+		int count{0};
+		// The volume of the loudest request.
+		float loudest{0};
+		// The sum of the requests' volumes.
+		float total_volume{0};
+		// The sum of the requests' pans weighted by their volumes.
+		float weighted_pan{0};
+		// The sum of the requests' pitches weighted by their volumes.
+		float weighted_pitch{0};
+	};
+	// Voice sound effects are played on.
+	struct voice {
+		// The source of the voice.
+		std::optional<tr::audio::source> source;
+		// The priority of the sound effect last played on the voice.
+		int priority{0};
+		// The time the sound effect last played on the voice was started.
+		std::chrono::steady_clock::time_point start{};
+	};
+
 	// Loaded sound effect data.
 	std::array<std::optional<tr::audio::buffer>, int(sound::COUNT)> m_sounds;
+	// Sound effects queued since the last dispatch.
+	std::array<queued_sound, int(sound::COUNT)> m_queued_sounds;
+	// Preallocated voices sound effects are played on.
+	std::array<voice, SOUND_VOICE_COUNT> m_voices;
 	// The currently playing song.
 	std::optional<tr::audio::source> m_current_song;
 
@@ -71,4 +113,9 @@ class audio {
 	audio();
 	// Shuts down the audio manager.
 	~audio();
+
+	// Picks the voice a sound effect with a given priority should be played on (nullptr if all voices play more important sounds).
+	voice* pick_voice(int priority, std::chrono::steady_clock::time_point now);
+	// Plays a merged sound effect.
+	void play_queued_sound(sound sound, const queued_sound& queued, std::chrono::steady_clock::time_point now);
 };
\ No newline at end of file
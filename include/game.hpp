@@ -3,15 +3,22 @@
 // Provides game simulation classes.                                                                                                     //
 //                                                                                                                                       //
 // Game hierarchy:                                                                                                                       //
-// • playerless_game     - No player object or most mechanics, only the balls, used for menu backgrounds.                                //
-//     • game            - Implements the player and mechanics, undefined input method.                                                  //
-//         • active_game - Input is taken from the mouse.                                                                                //
-//         • replay_game - Input is taken from a replay file.                                                                            //
+// • playerless_game       - No player object or most mechanics, only the balls, used for menu backgrounds.                            //
+//     • game              - Implements the player and mechanics, undefined input method.                                              //
+//         • active_game   - Input is taken from the mouse.                                                                            //
+//         • replay_game   - Input is taken from a replay file.                                                                        //
+//         • bot_game      - Input is picked by a dodging bot (see game/bot.hpp).                                                      //
+//         • snapshot_game - Not simulated, only mirrors snapshots of another game (see game_thread.hpp).                              //
+//                                                                                                                                       //
+// Games don't play sounds or shake the screen themselves, they report these to the event sink passed to tick() (see game_events.hpp).   //
+// Snapshots of a game's simulation state can be taken and restored. Replay games keep one for every 10 seconds of played back inputs,   //
+// so seeking only has to simulate from the nearest one onwards.                                                                         //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 #include "game/ball.hpp"
+#include "game/bot.hpp"
 #include "game/life_fragment.hpp"
 #include "game/player.hpp"
 #include "gamemode.hpp"
@@ -19,6 +26,66 @@
 
 class input;
 
+//////////////////////////////////////////////////////////////// SNAPSHOTS ////////////////////////////////////////////////////////////////
+
+// Snapshot of the simulation state of a playerless game.
+struct playerless_game_snapshot {
+	// Random number generator for gameplay.
+	tr::xorshiftr_128p rng;
+	// List of balls.
+	ball_list balls;
+	// Elapsed time since the game began.
+	ticks elapsed_time;
+	// Elapsed time since the last ball was spawned.
+	ticks time_since_last_ball;
+	// Radius of the next spawned ball.
+	float next_ball_size;
+	// Velocity of the next spawned ball.
+	float next_ball_velocity;
+};
+
+// Snapshot of the simulation state of a game.
+struct game_snapshot {
+	// State of the playerless part of the game.
+	playerless_game_snapshot base;
+	// Player state.
+	player_snapshot player;
+	// List of collectible life fragments.
+	std::array<life_fragment, 9> life_fragments;
+	// Fragments used to draw the animation of a life shattering after getting hit.
+	std::array<fragment, 6> shattered_life_fragments;
+	// Number of remaining lives.
+	int lives_left;
+	// Current achieved score.
+	i64 score;
+	// Timer measuring the elapsed time since game over.
+	startable_timer game_over_timer;
+	// Timer controlling the 1-UP animation.
+	decrementing_timer<0.2_s> one_up_animation_timer;
+	// Timer controlling the hit animation.
+	decrementing_timer<0.2_s> hit_animation_timer;
+	// Timer controlling the screen shake animation
+	decrementing_timer<0.67_s> screen_shake_timer;
+	// Timer controlling the sytle cooldown.
+	decrementing_timer<0.1_s> style_cooldown_timer;
+	// Timer controlling the score display animation,
+	decrementing_timer<0.1_s> score_animation_timer;
+	// Timer counting the time spent in the center region.
+	accumulating_timer<3_s> center_timer;
+	// Timer counting the time spent in an edge region.
+	accumulating_timer<3_s> edge_timer;
+	// Timer counting the time spent in a corner region.
+	accumulating_timer<3_s> corner_timer;
+	// Timer controlling the lives display hiding animation.
+	accumulating_timer<0.25_s> lives_hover_timer;
+	// Timer controlling the timer display hiding animation.
+	accumulating_timer<0.25_s> timer_hover_timer;
+	// Timer controlling the score display hiding animation.
+	accumulating_timer<0.25_s> score_hover_timer;
+	// Flag denoting whether the next second tick sound should be a deeper "tock".
+	bool tock;
+};
+
 ///////////////////////////////////////////////////////////// PLAYERLESS_GAME /////////////////////////////////////////////////////////////
 
 // Base game state (no player).
@@ -29,20 +96,34 @@ class playerless_game {
 
 	// Gets the gamemode of the game.
 	const gamemode& gamemode() const;
+	// Gets the number of balls in the game.
+	usize ball_count() const;
 
 	// Updates the game state.
-	void tick();
+	void tick(game_event_sink& events);
 
-	// Adds the game to the renderer.
-	void add_to_renderer(renderer& renderer, float secondary_hue) const;
+	// Takes a snapshot of the game's simulation state.
+	playerless_game_snapshot snapshot() const;
+	// Restores the game's simulation state from a snapshot.
+	void restore(const playerless_game_snapshot& snapshot);
+	// Copies the simulation state of another game into the game's existing state.
+	void copy_state(const playerless_game& source);
+	// Gets a hash of the game's simulation state (used to check that simulations match across builds).
+	u64 state_hash() const;
+
+	// Adds the game to the renderer, interpolated between the previous and current tick by a factor of alpha.
+	void add_to_renderer(renderer& renderer, float secondary_hue, float alpha = 1) const;
 
   protected:
+	// Adds the game's simulation state to a hash.
+	void add_to_hash(state_hasher& hasher) const;
+
 	// The gamemode of the game.
 	const ::gamemode m_gamemode;
 	// Random number generator for gameplay.
 	tr::xorshiftr_128p m_rng;
 	// List of balls.
-	tr::static_vector<ball, 255> m_balls;
+	ball_list m_balls;
 	// Elapsed time since the game began.
 	ticks m_elapsed_time;
 
@@ -107,16 +188,34 @@ class game : private playerless_game {
 	ticks final_time() const;
 	// Gets the gamemode of the game.
 	using playerless_game::gamemode;
+	// Gets the number of balls in the game.
+	using playerless_game::ball_count;
 
 	// Updates the game.
-	virtual void tick() = 0;
+	virtual void tick(game_event_sink& events) = 0;
+
+	// Takes a snapshot of the game's simulation state.
+	game_snapshot snapshot() const;
+	// Restores the game's simulation state from a snapshot.
+	void restore(const game_snapshot& snapshot);
+	// Copies the simulation state of another game into the game's existing state.
+	void copy_state(const game& source);
+	// Gets a hash of the game's simulation state (used to check that simulations match across builds).
+	u64 state_hash() const;
 
-	// Adds the game to the renderer.
-	void add_to_renderer(renderer& renderer, float primary_hue, float secondary_hue) const;
+	// Adds the game to the renderer, interpolated between the previous and current tick by a factor of alpha.
+	void add_to_renderer(renderer& renderer, float primary_hue, float secondary_hue, float alpha = 1) const;
 
   protected:
 	// Base update function taking in a player input.
-	void tick(const glm::vec2& input);
+	void tick(const glm::vec2& input, game_event_sink& events);
+
+	// Gets the list of balls.
+	const ball_list& balls() const;
+	// Gets the player's hitbox.
+	const tr::circle& player_hitbox() const;
+	// Gets the game result color picker.
+	const results_color_picker& result_color_picker() const;
 
   private:
 	// Information needed for rendering the timer display.
@@ -136,8 +235,8 @@ class game : private playerless_game {
 		float scale;
 	};
 
-	// Atlas holding the digits used by the timer and score displays.
-	mutable std::variant<tr::gfx::bitmap_atlas<char>, tr::gfx::dyn_atlas<char>> m_number_atlas;
+	// Sizes of the characters of the renderer's number atlas in field units (copied when the game is drawn, zero until then).
+	mutable std::array<glm::vec2, 12> m_number_sizes{};
 	// Game result color picker.
 	results_color_picker m_result_color_picker;
 	// Player state.
@@ -178,40 +277,40 @@ class game : private playerless_game {
 	bool m_tock;
 
 	// Gets the size of a string of text.
-	glm::vec2 text_size(const std::string& text, float renderer_scale, float scale) const;
+	glm::vec2 text_size(std::string_view text, float scale) const;
 	// Gets information needed for rendering the timer display.
 	timer_render_info timer_render_info() const;
 	// Gets information needed for rendering the score display.
 	score_render_info score_render_info() const;
 
 	// Plays the tick second on second marks.
-	void play_tick_sound_if_needed();
+	void play_tick_sound_if_needed(game_event_sink& events);
 	// Updates the various game timers.
 	void update_timers();
 	// Updates the collectible life fragments.
-	void update_life_fragments();
+	void update_life_fragments(game_event_sink& events);
 	// Checks if the player is hovering over the timer display and increments or decrements the related timer based on the result.
-	void check_if_timer_obstructed(float renderer_scale);
+	void check_if_timer_obstructed();
 	// Checks if the player is hovering over the lives display and increments or decrements the related timer based on the result.
 	void check_if_lives_obstructed();
 	// Checks if the player is hovering over the score display and increments or decrements the related timer based on the result.
-	void check_if_score_obstructed(float renderer_scale);
+	void check_if_score_obstructed();
 	// Checks for and handles the player getting hit.
-	void check_if_player_was_hit();
+	void check_if_player_was_hit(game_event_sink& events);
 	// Sets up the fragments used for the shattered life animation.
 	void set_up_shattered_life_fragments();
 	// Checks for and handles the player collecting life fragments.
-	void check_if_player_collected_life_fragments();
+	void check_if_player_collected_life_fragments(game_event_sink& events);
 	// Adds to the score.
 	void add_to_score(i64 change);
 	// Checks for and applies score ticks.
 	void check_for_score_ticks();
 	// Determines whether the player is in a ball's style region.
-	bool player_in_ball_style_region(const ball& ball, float ball_velocity) const;
+	bool player_in_ball_style_region(const tr::circle& ball_hitbox, glm::vec2 ball_velocity) const;
 	// Checks for and applies style points.
-	void check_for_style_points();
+	void check_for_style_points(game_event_sink& events);
 	// Applies screenshake.
-	void set_screen_shake(renderer& renderer) const;
+	void set_screen_shake(game_event_sink& events) const;
 
 	// Adds the timer display to the renderer.
 	void add_timer_to_renderer(renderer& renderer) const;
@@ -223,6 +322,8 @@ class game : private playerless_game {
 	void add_shattering_life_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 color, u8 base_opacity) const;
 	// Adds the score display to the renderer.
 	void add_score_to_renderer(renderer& renderer) const;
+
+	friend class snapshot_game;
 };
 
 /////////////////////////////////////////////////////////////// ACTIVE GAME ///////////////////////////////////////////////////////////////
@@ -230,11 +331,14 @@ class game : private playerless_game {
 // Game that is actively being played.
 class active_game final : public game {
   public:
-	// Creates a new active game.
-	active_game(const input& input, savefile savefile, ::gamemode gamemode, u64 seed = g_rng.generate<u64>());
+	// Creates a new active game, recording its replay in a directory.
+	active_game(const input& input, savefile_snapshot savefile, ::gamemode gamemode, u64 seed = g_rng.generate<u64>(),
+				const std::filesystem::path& replay_directory = debug_settings::instance().user_directory() / "replays");
 
 	// Updates the game state.
-	void tick() override;
+	void tick(game_event_sink& events) override;
+	// Updates the game state using a given mouse position instead of reading it from the input manager.
+	void tick(glm::vec2 mouse_pos, game_event_sink& events);
 
 	// Replay recorded of the game.
 	replay replay;
@@ -249,8 +353,8 @@ class active_game final : public game {
 // Game that is being played back through a replay.
 class replay_game final : public game {
   public:
-	// Creates a replay game from a replay.
-	replay_game(replay&& replay);
+	// Creates a replay game from a replay (the savefile is used to pick the colors of the results).
+	replay_game(replay&& replay, savefile_snapshot savefile);
 	// Creates a replay game using the same replay as an existing replay game.
 	replay_game(const replay_game& r);
 
@@ -258,11 +362,60 @@ class replay_game final : public game {
 	bool done() const;
 	// Gets the current position of the replay's mouse position.
 	glm::vec2 cursor_pos() const;
+	// Gets the number of replay inputs that have been played back.
+	usize position() const;
+	// Gets the number of replay inputs after which the game state first didn't match the recorded one (if a desync was detected).
+	std::optional<usize> first_desync() const;
 
 	// Updates the game state.
-	void tick() override;
+	void tick(game_event_sink& events) override;
+	// Moves the playback to a replay input (or as close to it as the replay's length allows).
+	void seek(usize position);
 
   private:
 	// The replay being read from.
 	replay m_replay;
+	// Snapshots of the game taken every KEYFRAME_INTERVAL inputs, in order.
+	std::vector<game_snapshot> m_keyframes;
+	// The earliest position at which the game state didn't match the recorded one.
+	std::optional<usize> m_first_desync;
+
+	// Creates a replay game from a replay with a given results color picker.
+	replay_game(replay&& replay, results_color_picker results_color_picker);
+
+	// Compares the game state against the one recorded in the replay at the current position.
+	void check_state_hash();
+};
+
+//////////////////////////////////////////////////////////////// BOT GAME /////////////////////////////////////////////////////////////////
+
+// Game whose input is picked by a dodging bot.
+class bot_game final : public game {
+  public:
+	// Creates a bot game.
+	bot_game(::gamemode gamemode, u64 seed, const bot_settings& settings = {});
+	// Creates a bot game recording a replay to a directory.
+	bot_game(::gamemode gamemode, u64 seed, const bot_settings& settings, const std::filesystem::path& replay_directory);
+
+	// Updates the game state.
+	void tick(game_event_sink& events) override;
+
+	// Replay recorded of the game (if one is being recorded).
+	std::optional<replay> replay;
+
+  private:
+	// The bot playing the game.
+	bot m_bot;
+};
+
+////////////////////////////////////////////////////////////// SNAPSHOT GAME //////////////////////////////////////////////////////////////
+
+// Game that doesn't simulate anything itself and only mirrors snapshots of another game (used to draw games simulated on another thread).
+class snapshot_game final : public game {
+  public:
+	// Creates a snapshot game mirroring the current state of another game.
+	snapshot_game(const game& source);
+
+	// Does nothing, snapshot games are only updated through restore() and copy_state().
+	void tick(game_event_sink& events) override;
 };
\ No newline at end of file
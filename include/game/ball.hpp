@@ -1,53 +1,97 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                                       //
-// Provides a ball game object class.                                                                                                    //
+// Provides a container class for the ball game objects.                                                                                 //
+//                                                                                                                                       //
+// Balls are stored as a structure of arrays: positions, velocities, radii and ages are kept in separate tightly-packed arrays, while    //
+// the trails (which are only pushed to once per tick and otherwise only read when drawing) are kept apart from them. Integration is     //
+// first done speculatively for all balls in a branchless pass the compiler can vectorize, after which balls are processed in order as   //
+// before, falling back to the scalar path for any ball that hits a wall or had its velocity changed by a collision earlier in the same  //
+// tick.                                                                                                                                 //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include "game_events.hpp"
 #include "trail.hpp"
 
 class renderer;
 
-/////////////////////////////////////////////////////////////////// BALL //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Maximum number of balls in a game.
+inline constexpr usize MAX_BALLS{255};
 
-// Ball object.
-class ball {
+////////////////////////////////////////////////////////////////// BALLS //////////////////////////////////////////////////////////////////
+
+// List of ball objects.
+class ball_list {
   public:
-	// Creates a ball.
-	ball(const tr::circle& hitbox, const glm::vec2& velocity);
+	// Gets the number of balls.
+	usize size() const;
+	// Gets whether a ball is tangible.
+	bool tangible(usize i) const;
+	// Gets the hitbox of a ball.
+	tr::circle hitbox(usize i) const;
+	// Gets the velocity of a ball.
+	glm::vec2 velocity(usize i) const;
+
+	// Adds a ball.
+	void emplace(const tr::circle& hitbox, glm::vec2 velocity);
 	// Randomly generates a ball.
-	ball(tr::xorshiftr_128p& rng, float size, float velocity);
+	void emplace(tr::xorshiftr_128p& rng, float size, float velocity);
 
-	// Gets whether the ball is tangible.
-	bool tangible() const;
-	// Gets the hitbox of the ball.
-	const tr::circle& hitbox() const;
-	// Gets the velocity of the ball.
-	const glm::vec2& velocity() const;
+	// Updates the balls and handles the collisions between them.
+	void tick(game_event_sink& events);
 
-	// Updates the ball's state.
-	void tick();
+	// Adds the state of the balls to a hash.
+	void add_to_hash(state_hasher& hasher) const;
 
-	// Adds the ball to the renderer.
-	void add_to_renderer(renderer& renderer, float hue) const;
+	// Adds the balls to the renderer, interpolated between the previous and current tick by a factor of alpha.
+	void add_to_renderer(renderer& renderer, float hue, float alpha = 1) const;
 
   private:
-	// The ball's hitbox.
-	tr::circle m_hitbox;
-	// The ball's trail.
-	trail m_trail;
-	// The ball's current velocity.
-	glm::vec2 m_velocity;
-	// Time elapsed since the ball was spawned.
-	ticks m_age;
-	// Time elapsed since the ball last hit something.
-	ticks m_time_since_last_collision;
-
-	friend void handle_collision(ball& a, ball& b);
-};
-
-// Gets whether two balls are colliding.
-bool colliding(const ball& a, const ball& b);
-// Handles the collision between two balls.
-void handle_collision(ball& a, ball& b);
\ No newline at end of file
+	// Results of the speculative integration pass.
+	struct integration {
+		// The target X coordinates of the balls.
+		std::array<float, MAX_BALLS> xs;
+		// The target Y coordinates of the balls.
+		std::array<float, MAX_BALLS> ys;
+		// Whether the targets are strictly within the field (and thus don't need to be reflected).
+		std::array<u8, MAX_BALLS> in_bounds;
+	};
+
+	// The number of balls.
+	usize m_size{0};
+	// The X coordinates of the balls' hitboxes.
+	std::array<float, MAX_BALLS> m_xs;
+	// The Y coordinates of the balls' hitboxes.
+	std::array<float, MAX_BALLS> m_ys;
+	// The X components of the balls' velocities.
+	std::array<float, MAX_BALLS> m_vxs;
+	// The Y components of the balls' velocities.
+	std::array<float, MAX_BALLS> m_vys;
+	// The radii of the balls' hitboxes.
+	std::array<float, MAX_BALLS> m_radii;
+	// Time elapsed since the balls were spawned.
+	std::array<ticks, MAX_BALLS> m_ages;
+	// Time elapsed since the balls last hit something.
+	std::array<ticks, MAX_BALLS> m_times_since_last_collision;
+	// The balls' trails.
+	tr::static_vector<trail, MAX_BALLS> m_trails;
+
+	// Speculatively moves all balls without reflecting them off of the walls.
+	void integrate(integration& out) const;
+	// Moves a ball, reflecting it off of the walls if needed.
+	void move_and_reflect(usize i, game_event_sink& events);
+	// Gets whether two balls are colliding.
+	bool colliding(usize a, usize b) const;
+	// Handles the collision between two balls.
+	void handle_collision(usize a, usize b, game_event_sink& events);
+
+	// Gets the position of a ball interpolated between the previous and current tick.
+	glm::vec2 interpolated_pos(usize i, float alpha) const;
+	// Adds a ball to the renderer.
+	void add_to_renderer(renderer& renderer, usize index, glm::vec2 pos, tr::rgb8 tint) const;
+	// Adds a ball's trail to the renderer.
+	void add_trail_to_renderer(renderer& renderer, usize index, glm::vec2 pos, float hue) const;
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides an avoidance AI that plays the game in place of a player.                                                                    //
+//                                                                                                                                       //
+// Every tick, the bot considers moving towards a set of targets around the player (as well as staying in place). For each of them, it   //
+// predicts where the player (accounting for its inertia) and the balls (accounting for wall bounces) will be over a short time window,  //
+// and rates the target by how close those predictions bring the player to the balls and the walls. The least dangerous target is        //
+// picked.                                                                                                                               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "ball.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Number of points in time the bot predicts the player and ball positions at.
+inline constexpr usize BOT_PREDICTION_SAMPLES{5};
+// Number of directions the bot considers moving in.
+inline constexpr usize BOT_DIRECTIONS{16};
+
+////////////////////////////////////////////////////////////// BOT SETTINGS ///////////////////////////////////////////////////////////////
+
+// Settings of the bot's avoidance AI.
+struct bot_settings {
+	// How far ahead the bot predicts the movement of the player and balls, in seconds.
+	float lookahead{0.75f};
+	// Clearance from the balls the bot tries to keep.
+	float ball_margin{40};
+	// Clearance from the walls the bot tries to keep.
+	float wall_margin{60};
+	// Distance to the furthest targets the bot considers.
+	float reach{200};
+	// How strongly the bot prefers staying close to the center of the field.
+	float center_weight{0.05f};
+};
+
+/////////////////////////////////////////////////////////////////// BOT ///////////////////////////////////////////////////////////////////
+
+// Avoidance AI steering the player away from the balls.
+class bot {
+  public:
+	// Creates a bot.
+	bot(const bot_settings& settings = {});
+
+	// Picks the input for the next tick.
+	glm::vec2 steer(const tr::circle& player_hitbox, float inertia_factor, const ball_list& balls) const;
+
+  private:
+	// The bot's settings.
+	bot_settings m_settings;
+
+	// Rates how dangerous moving towards a target is.
+	float danger(const tr::circle& player_hitbox, glm::vec2 target, std::span<const float, BOT_PREDICTION_SAMPLES> remaining_offsets,
+				 const ball_list& balls) const;
+};
\ No newline at end of file
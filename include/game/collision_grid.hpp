@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a uniform grid used as the broad phase of ball-ball collision detection.                                                     //
+//                                                                                                                                       //
+// The grid is rebuilt at the start of every tick and updated as balls move. Candidates are always returned in ascending ball index      //
+// order so that collisions are handled in exactly the same order as a pairwise check would, which keeps replays in sync.                //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "ball.hpp"
+
+///////////////////////////////////////////////////////////// COLLISION GRID //////////////////////////////////////////////////////////////
+
+// Uniform grid over the playing field holding ball indices.
+class collision_grid {
+  public:
+	// Builds a grid out of a list of balls.
+	collision_grid(const ball_list& balls);
+
+	// Moves a ball to the cell corresponding to its current position.
+	void update(u8 index, glm::vec2 pos);
+	// Gets the indices of balls after a given ball that may be colliding with it, in ascending order.
+	const tr::static_vector<u8, MAX_BALLS>& candidates_after(u8 index);
+
+  private:
+	// Maximum number of cells along one axis.
+	static constexpr int MAX_CELLS_PER_AXIS{32};
+	// Sentinel denoting the end of a cell's list.
+	static constexpr u8 NO_BALL{255};
+
+	// The number of cells along one axis.
+	int m_cells_per_axis;
+	// The length of the side of a cell.
+	float m_cell_size;
+	// The first ball of each cell's list.
+	std::array<u8, MAX_CELLS_PER_AXIS * MAX_CELLS_PER_AXIS> m_heads;
+	// The next ball in the list of each ball.
+	std::array<u8, MAX_BALLS> m_next;
+	// The previous ball in the list of each ball.
+	std::array<u8, MAX_BALLS> m_prev;
+	// The cell each ball is in.
+	std::array<u16, MAX_BALLS> m_cells;
+	// Buffer holding the last list of candidates.
+	tr::static_vector<u8, MAX_BALLS> m_candidates;
+
+	// Gets the cell coordinates of a position.
+	glm::ivec2 cell_of(glm::vec2 pos) const;
+	// Inserts a ball into a cell.
+	void link(u8 index, u16 cell);
+	// Removes a ball from its cell.
+	void unlink(u8 index);
+};
\ No newline at end of file
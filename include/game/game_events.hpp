@@ -0,0 +1,34 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides the interface through which the game simulation emits events handled by outside systems.                                     //
+//                                                                                                                                       //
+// The simulation never talks to the audio manager or renderer directly. Sounds and screen shake are instead reported to an event sink,  //
+// which allows games to be stepped without a window or audio device (for example when verifying or benchmarking replays).               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../audio.hpp"
+
+//////////////////////////////////////////////////////////// GAME EVENT SINK //////////////////////////////////////////////////////////////
+
+// Interface for receiving events emitted by the game simulation.
+class game_event_sink {
+  public:
+	// Virtual destructor.
+	virtual ~game_event_sink() = default;
+
+	// Handles a sound effect emitted by the simulation.
+	virtual void play_sound(sound sound, float volume, float pan, float pitch = 1) = 0;
+	// Handles the screen being shaken to an offset.
+	virtual void shake_screen(glm::vec2 offset) = 0;
+};
+
+// Event sink that discards all events.
+class null_event_sink : public game_event_sink {
+  public:
+	// Discards a sound effect.
+	void play_sound(sound, float, float, float = 1) override {}
+	// Discards a screen shake.
+	void shake_screen(glm::vec2) override {}
+};
\ No newline at end of file
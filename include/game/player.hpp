@@ -13,6 +13,18 @@ class renderer;
 
 ////////////////////////////////////////////////////////////////// PLAYER /////////////////////////////////////////////////////////////////
 
+// Snapshot of the simulation state of a player.
+struct player_snapshot {
+	// The player's hitbox.
+	tr::circle hitbox;
+	// The player's trail.
+	::trail trail;
+	// List of the player's fragments when they die.
+	std::array<fragment, 6> fragments;
+	// Timer controlling the player's invincibility.
+	decrementing_timer<2_s> invincibility_timer;
+};
+
 // Player object.
 class player {
   public:
@@ -33,9 +45,16 @@ class player {
 	// Updates the state of the player's death fragments.
 	void update_fragments();
 
-	// Adds the living player to the renderer.
+	// Takes a snapshot of the player's simulation state.
+	player_snapshot snapshot() const;
+	// Restores the player's simulation state from a snapshot.
+	void restore(const player_snapshot& snapshot);
+	// Copies the simulation state of another player into the player's existing state.
+	void copy_state(const player& source);
+
+	// Adds the living player to the renderer, interpolated between the previous and current tick by a factor of alpha.
 	void add_to_renderer_alive(renderer& renderer, float hue, ticks time_since_start,
-							   const decrementing_timer<0.1_s>& style_cooldown_timer) const;
+							   const decrementing_timer<0.1_s>& style_cooldown_timer, float alpha = 1) const;
 	// Adds the dead player to the renderer.
 	void add_to_renderer_dead(renderer& renderer, float hue, ticks time_since_game_over) const;
 
@@ -61,15 +80,18 @@ class player {
 	// Tries to load a player skin from "player.png" in the user directory.
 	void try_loading_skin(tr::gfx::renderer_2d& renderer) const;
 	// Adds the player's skin to the renderer.
-	void add_skin_to_renderer(tr::gfx::renderer_2d& renderer, u8 opacity, tr::angle rotation, float size) const;
+	void add_skin_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, u8 opacity, tr::angle rotation, float size) const;
 	// Adds the skinless player visual's fill to the renderer.
-	void add_fill_to_renderer(tr::gfx::renderer_2d& renderer, u8 opacity, tr::angle rotation, float size) const;
+	void add_fill_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, u8 opacity, tr::angle rotation, float size) const;
 	// Adds the skinless player visual's outline to the renderer.
-	void add_outline_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 tint, u8 opacity, tr::angle rotation, float size) const;
+	void add_outline_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, tr::rgb8 tint, u8 opacity, tr::angle rotation,
+								 float size) const;
 	// Adds the player's trail to the renderer.
-	void add_trail_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 tint, u8 opacity, tr::angle rotation, float size) const;
+	void add_trail_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, tr::rgb8 tint, u8 opacity, tr::angle rotation,
+							   float size) const;
 	// Adds the wave emitted after getting style points to the renderer.
-	void add_style_wave_to_renderer(tr::gfx::circle_renderer& renderer, tr::rgb8 tint, const decrementing_timer<0.1_s>& timer) const;
+	void add_style_wave_to_renderer(tr::gfx::circle_renderer& renderer, glm::vec2 pos, tr::rgb8 tint,
+									const decrementing_timer<0.1_s>& timer) const;
 	// Adds the player's death wave to the renderer.
 	void add_death_wave_to_renderer(tr::gfx::circle_renderer& renderer, tr::rgb8 tint, ticks time_since_game_over) const;
 	// Adds the player's death fragments to the renderer.
@@ -0,0 +1,30 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides the math functions used by the game simulation where results have to be reproducible.                                        //
+//                                                                                                                                       //
+// Replays only play back correctly if the simulation produces bit-identical results on the recording and viewing side. Basic arithmetic //
+// and square roots are exactly rounded by IEEE 754, so they are reproducible as long as the compiler doesn't fuse or reorder them       //
+// (which BODGE_STRICT_FP builds forbid, see CMakeLists.txt). Trigonometric functions from the standard library or tr, however, differ   //
+// between compilers, standard libraries and optimization levels.                                                                        //
+//                                                                                                                                       //
+// In BODGE_STRICT_FP builds, the functions below are implemented using only exactly rounded operations and are thus bit-reproducible    //
+// everywhere. Otherwise, they forward to the standard library and tr as the simulation always did, which keeps older replays working    //
+// but only between builds made with the same compiler (see replay.hpp).                                                                 //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../global.hpp"
+
+///////////////////////////////////////////////////////////// SIMULATION MATH /////////////////////////////////////////////////////////////
+
+// Creates a vector from a magnitude and an angle.
+glm::vec2 sim_magth(float magnitude, tr::angle th);
+// Generates a vector with a given magnitude and a random direction.
+glm::vec2 sim_random_vector(tr::xorshiftr_128p& rng, float magnitude);
+// Calculates the angle of a vector.
+tr::angle sim_atan2(float y, float x);
+// Rotates a point around a center.
+glm::vec2 sim_rotate_around(glm::vec2 point, glm::vec2 center, tr::angle th);
+// Raises a non-negative number to the power of 1.5.
+float sim_pow_1_5(float x);
\ No newline at end of file
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a thread that simulates a game independently of the thread that draws it.                                                    //
+//                                                                                                                                       //
+// The game thread ticks its game at the fixed simulation rate on its own and never waits on the main thread. After every tick, it       //
+// copies the state of the game in place into a snapshot game held by a lock-free triple buffer and publishes it, and the main thread    //
+// draws the latest published snapshot game directly, so no copies are made on the main thread and nothing is reconstructed on either.   //
+// Sound effects requested during a tick are merged per sound effect and pushed into a lock-free queue together with the latest screen   //
+// shake once the tick is done, to be dispatched by the main thread, as the audio manager and renderer may only be used from there.      //
+// Whatever doesn't fit into the queue stays pending and is merged with the requests of the following ticks, so no sound effect is ever  //
+// dropped. The mouse position is handed to the simulation through atomics; the simulation quantizes and records whichever position it   //
+// reads, so replays stay exact.                                                                                                         //
+//                                                                                                                                       //
+// Every frame is stamped with the time it was published at, which lets the main thread draw moving objects interpolated between the     //
+// previous and latest tick, so motion stays even at refresh rates that aren't a divisor of the tick rate.                               //
+//                                                                                                                                       //
+// The game must not be touched by anything else while its game thread exists, destroying the game thread stops and joins it.            //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "game.hpp"
+#include "triple_buffer.hpp"
+#include <thread>
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Maximum number of simulation events that can be waiting to be dispatched (more are held back by the simulation until there's space).
+inline constexpr usize GAME_EVENT_QUEUE_SIZE{256};
+
+/////////////////////////////////////////////////////////////// GAME THREAD ///////////////////////////////////////////////////////////////
+
+// Thread simulating a game.
+class game_thread : private game_event_sink {
+  public:
+	// Starts simulating a game on a new thread.
+	game_thread(std::shared_ptr<game> game);
+
+	// Gets the copy of the game as of the latest fetched frame.
+	const game& frame() const;
+	// Gets whether the replay (if the game is a replay game) was done playing as of the latest fetched frame.
+	bool replay_done() const;
+	// Gets the replay cursor position (if the game is a replay game) as of the latest fetched frame.
+	glm::vec2 replay_cursor_pos() const;
+	// Gets the number of replay inputs after which the replay (if the game is a replay game) first desynced as of the latest fetched frame.
+	std::optional<usize> replay_first_desync() const;
+	// Gets how far the simulation should be into the tick after the latest fetched frame by now (0 - just published, 1 - a full tick).
+	float interpolation_factor() const;
+
+	// Sets the speed multiplier of the simulation.
+	void set_speed(float speed);
+	// Sets the mouse position fed to active games.
+	void set_mouse_pos(glm::vec2 mouse_pos);
+
+	// Fetches the latest frame published by the simulation, if there is a new one.
+	void update();
+	// Dispatches the events emitted by the simulation since the last call to another event sink.
+	void dispatch_events(game_event_sink& sink);
+
+  private:
+	// Sound effect emitted by the simulation.
+	struct sound_event {
+		// The sound effect.
+		::sound sound;
+		// The volume of the sound effect.
+		float volume;
+		// The pan of the sound effect.
+		float pan;
+		// The pitch of the sound effect.
+		float pitch;
+	};
+	// Screen shake emitted by the simulation.
+	struct shake_event {
+		// The offset of the screen.
+		glm::vec2 offset;
+	};
+	// Generic simulation event.
+	using event = std::variant<sound_event, shake_event>;
+	// Requests of a sound effect made by the simulation that weren't queued yet, merged together.
+	struct pending_sound {
+		// The number of merged requests.
+		int count{0};
+		// The volume of the loudest request.
+		float loudest{0};
+		// The sum of the requests' volumes.
+		float total_volume{0};
+		// The sum of the requests' pans weighted by their volumes.
+		float weighted_pan{0};
+		// The sum of the requests' pitches weighted by their volumes.
+		float weighted_pitch{0};
+	};
+	// State of the game published after every tick.
+	struct frame_data {
+		// Copy of the game (its state is copied in place, so the slot is reused rather than reconstructed every tick).
+		snapshot_game snapshot;
+		// Whether the replay was done playing.
+		bool replay_done;
+		// The replay cursor position.
+		glm::vec2 replay_cursor_pos;
+		// The number of replay inputs after which the game state first didn't match the recorded one (if a desync was detected).
+		std::optional<usize> replay_first_desync;
+		// The time the frame was published at.
+		std::chrono::steady_clock::time_point publish_time;
+		// The time until the next frame is scheduled to be published.
+		std::chrono::duration<float> tick_duration;
+	};
+
+	// The simulated game.
+	std::shared_ptr<game> m_game;
+	// The simulated game if it's an active game, otherwise nullptr.
+	active_game* m_active_game;
+	// The simulated game if it's a replay game, otherwise nullptr.
+	replay_game* m_replay_game;
+	// Frames published by the simulation.
+	triple_buffer<frame_data> m_frames;
+	// Speed multiplier of the simulation.
+	std::atomic<float> m_speed{1};
+	// X coordinate of the mouse position fed to active games.
+	std::atomic<float> m_mouse_x;
+	// Y coordinate of the mouse position fed to active games.
+	std::atomic<float> m_mouse_y;
+	// Ring buffer of events waiting to be dispatched.
+	std::array<event, GAME_EVENT_QUEUE_SIZE> m_events;
+	// Number of events dispatched so far (only written by the main thread).
+	std::atomic<usize> m_events_read{0};
+	// Number of events queued so far (only written by the simulation thread).
+	std::atomic<usize> m_events_written{0};
+	// Sound effects requested by the simulation that weren't queued yet (only used by the simulation thread).
+	std::array<pending_sound, int(sound::COUNT)> m_pending_sounds;
+	// Latest screen shake emitted by the simulation that wasn't queued yet (only used by the simulation thread).
+	std::optional<glm::vec2> m_pending_shake;
+	// The simulation thread (declared last so that it's joined before anything it uses is destroyed).
+	std::jthread m_thread;
+
+	// Merges a sound effect emitted by the simulation into the pending ones.
+	void play_sound(::sound sound, float volume, float pan, float pitch = 1) override;
+	// Sets the pending screen shake.
+	void shake_screen(glm::vec2 offset) override;
+	// Queues the pending sound effects and screen shake, holding back whatever doesn't fit in the queue.
+	void queue_pending_events();
+	// Queues an event if there's space in the queue and returns whether it did.
+	bool push_event(const event& event);
+
+	// Publishes the current state of the game.
+	void publish_frame(std::chrono::duration<float> tick_duration);
+	// Main function of the simulation thread.
+	void run(std::stop_token stop_token);
+};
\ No newline at end of file
@@ -93,6 +93,9 @@ template <> struct tr::binary_writer<gamemode> {
 	static void write_to_stream(std::ostream& os, const gamemode& in);
 };
 
+// Built-in gamemodes that are always available.
+extern const std::array<gamemode, 6> BUILTIN_GAMEMODES;
+
 // Randomly picks a menu gamemode.
 gamemode pick_menu_gamemode();
 
@@ -105,6 +108,8 @@ struct gamemode_with_path {
 
 	bool operator==(const gamemode_with_path&) const = default;
 };
+// Loads a gamemode from a file.
+gamemode load_gamemode(const std::filesystem::path& path);
 // Loads all available gamemodes.
 std::vector<gamemode_with_path> load_gamemodes(const std::filesystem::path& directory = debug_settings::instance().user_directory() /
 																						"gamemodes");
\ No newline at end of file
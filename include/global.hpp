@@ -47,10 +47,17 @@ consteval float operator""_sf(long double seconds);
 // Converts a number of beats given a BPM to a value in ticks.
 consteval ticks beats_bpm(int beats, int bpm);
 
+// Buffer large enough to hold any formatted score or time.
+using number_buffer = std::array<char, 24>;
+
 // Formats a score.
 std::string format_score(i64 score);
+// Formats a score into a buffer without allocating.
+std::string_view format_score(number_buffer& buffer, i64 score);
 // Formats a time in ticks to (MM):SS:mm.
 std::string format_time(ticks time);
+// Formats a time in ticks to (MM):SS:mm into a buffer without allocating.
+std::string_view format_time(number_buffer& buffer, ticks time);
 // Formats a time in ticks to MM:SS:mm.
 std::string format_time_long(ticks time);
 // Formats a playtime in ticks to HH:MM:SS.
@@ -125,8 +132,24 @@ struct fragment {
 	void tick();
 };
 
-// The global RNG.
-inline tr::xorshiftr_128p g_rng;
+// Incremental hasher (64-bit FNV-1a) used to fingerprint simulation state.
+class state_hasher {
+  public:
+	// Adds the object representation of a value to the hash.
+	template <class T>
+		requires(std::is_trivially_copyable_v<T>)
+	void add(const T& value);
+
+	// Gets the hash of everything added so far.
+	u64 value() const;
+
+  private:
+	// The current hash.
+	u64 m_hash{0xCBF29CE484222325};
+};
+
+// The global RNG (thread-local so that games can be simulated on worker threads).
+inline thread_local tr::xorshiftr_128p g_rng;
 
 // Gets the current UNIX timestamp.
 i64 current_timestamp();
@@ -156,4 +179,13 @@ consteval float operator""_sf(long double seconds)
 consteval ticks beats_bpm(int beats, int bpm)
 {
 	return beats * 60_s / bpm;
+}
+
+template <class T>
+	requires(std::is_trivially_copyable_v<T>)
+void state_hasher::add(const T& value)
+{
+	for (std::byte byte : std::as_bytes(std::span{&value, 1})) {
+		m_hash = (m_hash ^ u64(byte)) * 0x100000001B3;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides modes in which Bodge runs from the command line without opening a window.                                                    //
+//                                                                                                                                       //
+// Replay verification re-simulates every replay in a directory as fast as possible and checks that the final score and time match the   //
+// ones recorded in the replay's header, and that the state hashes recorded in the replay match (reporting the first tick at which they  //
+// don't). Each replay game owns its own RNG and reports its events to a null sink, so replays are simulated in parallel on all          //
+// available cores.                                                                                                                      //
+//                                                                                                                                       //
+// The benchmarks step playerless and scripted games for every built-in gamemode (as well as stress cases with the maximum number of     //
+// balls) with fixed seeds on a single thread, and print per-tick timing percentiles and heap allocation counts as JSON.                 //
+//                                                                                                                                       //
+// The conformance check runs the same cases and hashes the simulation state every 10 seconds of game time, comparing the hashes to a    //
+// reference file (metadata/conformance_hashes.txt, recorded with --record) and failing at the first case and time whose hash doesn't    //
+// match. This shows whether (and when) the simulation of a build made with a different compiler or for a different platform diverges.   //
+//                                                                                                                                       //
+// The allocation check runs the same cases (plus active games recording their replays into a scratch directory, like the games players  //
+// play) with the global allocator hooked and fails if any tick makes a heap allocation, reporting how many allocations were made and    //
+// when the first one happened. The allocator is only hooked in builds made with BODGE_ALLOCATION_TRACKING (which the game players run   //
+// shouldn't be): elsewhere the allocation check fails immediately and the other modes report their allocation counts as null.           //
+//                                                                                                                                       //
+// The batch simulation loads a gamemode file (or takes a built-in gamemode by name) and simulates games of it with a range of seeds and //
+// an input policy ("scripted" follows the same fixed pattern as the benchmarks, "bot" dodges the balls), handing the games out to       //
+// worker threads on all available cores. Games are cut off after 30 minutes. It prints the distributions of survival times and scores,  //
+// the number of games in which the ball count reached the gamemode's maximum, the average number of balls over time and the simulation  //
+// throughput in ticks per second per core as JSON.                                                                                      //
+//                                                                                                                                       //
+// The soak test plays recorded bot games of the built-in gamemodes back to back for hours of game time, saving the replay of every      //
+// finished game (and of the game still running when the time runs out) so that any crash or desync can be reproduced. Every minute of   //
+// game time it prints the number of games played and of those in which the bot survived until the ball count reached the gamemode's     //
+// maximum, the tick time distribution and the number of live heap allocations, which shows slowdowns and leaks.                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "global.hpp"
+
+/////////////////////////////////////////////////////////// REPLAY VERIFICATION ///////////////////////////////////////////////////////////
+
+// Verifies all replays in a directory, printing a report to the standard output.
+tr::sys::signal verify_replays(const std::filesystem::path& directory);
+
+/////////////////////////////////////////////////////////////// BENCHMARKS ////////////////////////////////////////////////////////////////
+
+// Runs the simulation benchmarks, printing the results to the standard output as JSON.
+tr::sys::signal run_benchmarks();
+
+//////////////////////////////////////////////////////////// CONFORMANCE CHECK ////////////////////////////////////////////////////////////
+
+// Runs the simulation conformance check against (or recording) a file of reference hashes, printing a report to the standard output.
+tr::sys::signal run_conformance_check(const std::filesystem::path& reference_path, bool record);
+
+//////////////////////////////////////////////////////////// ALLOCATION CHECK /////////////////////////////////////////////////////////////
+
+// Runs the simulation allocation check, printing a report to the standard output.
+tr::sys::signal run_allocation_check();
+
+//////////////////////////////////////////////////////////// BATCH SIMULATION /////////////////////////////////////////////////////////////
+
+// Simulates games of a gamemode (a file or the name of a built-in gamemode) with consecutive seeds and an input policy, printing
+// statistics to the standard output as JSON.
+tr::sys::signal run_batch_simulation(const std::filesystem::path& gamemode_path, u64 first_seed, usize game_count, std::string_view policy);
+
+//////////////////////////////////////////////////////////////// SOAK TEST ////////////////////////////////////////////////////////////////
+
+// Plays bot games back to back for a number of minutes of game time, saving their replays to a directory and printing a report of the
+// tick times and live heap allocations every minute to the standard output.
+tr::sys::signal run_soak_test(usize minutes, const std::filesystem::path& replay_directory);
\ No newline at end of file
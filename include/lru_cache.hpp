@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a thread-safe least-recently-used cache.                                                                                     //
+//                                                                                                                                       //
+// Lookups only take a shared lock and mark entries as used through an atomic timestamp, so any number of threads can hit the cache at   //
+// the same time. Insertions take an exclusive lock and evict the least recently used entry once the cache is full.                      //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "global.hpp"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+//////////////////////////////////////////////////////////////// LRU CACHE ////////////////////////////////////////////////////////////////
+
+// Thread-safe least-recently-used cache.
+template <class K, class V, class Hash = std::hash<K>> class lru_cache {
+  public:
+	// Creates an empty cache with a maximum number of entries.
+	lru_cache(usize capacity);
+
+	// Looks up a value in the cache, marking it as recently used.
+	std::optional<V> find(const K& key);
+	// Inserts a value into the cache, evicting the least recently used entry if the cache is full.
+	void insert(K key, V value);
+	// Removes all entries from the cache.
+	void clear();
+
+  private:
+	// Cache entry.
+	struct entry {
+		// The cached value.
+		V value;
+		// Timestamp of the last time the entry was used.
+		std::atomic<u64> last_used;
+	};
+
+	// The maximum number of entries.
+	usize m_capacity;
+	// Mutex protecting the entry map (the entries' timestamps are atomic and updated under a shared lock).
+	std::shared_mutex m_mutex;
+	// The cache entries.
+	std::unordered_map<K, entry, Hash> m_entries;
+	// Source of usage timestamps.
+	std::atomic<u64> m_clock{0};
+};
+
+///////////////////////////////////////////////////////////// IMPLEMENTATION //////////////////////////////////////////////////////////////
+
+template <class K, class V, class Hash>
+lru_cache<K, V, Hash>::lru_cache(usize capacity)
+	: m_capacity{capacity}
+{
+}
+
+template <class K, class V, class Hash> std::optional<V> lru_cache<K, V, Hash>::find(const K& key)
+{
+	std::shared_lock lock{m_mutex};
+
+	const auto it{m_entries.find(key)};
+	if (it == m_entries.end()) {
+		return std::nullopt;
+	}
+	it->second.last_used.store(m_clock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+	return it->second.value;
+}
+
+template <class K, class V, class Hash> void lru_cache<K, V, Hash>::insert(K key, V value)
+{
+	std::unique_lock lock{m_mutex};
+
+	if (m_entries.size() >= m_capacity && !m_entries.contains(key)) {
+		const auto lru{std::ranges::min_element(m_entries, std::less{}, [](const auto& kv) { return kv.second.last_used.load(); })};
+		m_entries.erase(lru);
+	}
+	const u64 now{m_clock.fetch_add(1, std::memory_order_relaxed)};
+	const auto [it, inserted]{m_entries.try_emplace(std::move(key), std::move(value), now)};
+	if (!inserted) {
+		it->second.value = std::move(value);
+		it->second.last_used.store(now, std::memory_order_relaxed);
+	}
+}
+
+template <class K, class V, class Hash> void lru_cache<K, V, Hash>::clear()
+{
+	std::unique_lock lock{m_mutex};
+
+	m_entries.clear();
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a read-only view of a file's contents mapped into memory.                                                                    //
+//                                                                                                                                       //
+// On platforms with mmap the file is mapped lazily by the OS, so only the pages that are actually read are loaded from disk. Elsewhere  //
+// (notably Windows, which doesn't allow replacing a file that has a live mapping, something the savefile does whenever it is saved) the //
+// file is read into memory instead.                                                                                                     //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "global.hpp"
+
+/////////////////////////////////////////////////////////////// MAPPED FILE ///////////////////////////////////////////////////////////////
+
+// Read-only view of a file's contents.
+class mapped_file {
+  public:
+	// Maps a file into memory.
+	mapped_file(const std::filesystem::path& path);
+	// Unmaps the file.
+	~mapped_file();
+	// Mapped files can't be copied.
+	mapped_file(const mapped_file&) = delete;
+	// Mapped files can't be copied.
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	// Gets the contents of the file.
+	std::span<const std::byte> data() const;
+
+  private:
+	// The contents of the file.
+	std::span<const std::byte> m_data;
+	// Buffer holding the contents of the file if it couldn't be mapped.
+	std::vector<std::byte> m_buffer;
+	// Whether the contents are mapped (as opposed to read into the buffer).
+	bool m_mapped;
+};
\ No newline at end of file
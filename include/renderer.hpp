@@ -6,8 +6,11 @@
 
 #pragma once
 #include "renderer/blur_renderer.hpp"
+#include "renderer/glyph_atlas.hpp"
+#include "renderer/number_atlas.hpp"
 #include "renderer/text_engine.hpp"
 #include "renderer/tooltip_manager.hpp"
+#include "renderer/trail_renderer.hpp"
 #include "settings.hpp"
 
 ///////////////////////////////////////////////////////////////// RENDERER ////////////////////////////////////////////////////////////////
@@ -52,8 +55,14 @@ class renderer {
 	tr::gfx::renderer_2d& basic();
 	// Gets the circle renderer.
 	tr::gfx::circle_renderer& circle();
+	// Gets the ball trail renderer.
+	trail_renderer& trails();
 	// Renderer text engine.
 	text_engine text_engine;
+	// Gets the glyph atlas used to draw UI text.
+	glyph_atlas& glyphs();
+	// Gets the atlas used to draw the in-game timer and score displays.
+	const number_atlas& numbers() const;
 
 	// Sets the default transformation matrix.
 	void set_default_transform(const glm::mat4& mat);
@@ -65,7 +74,9 @@ class renderer {
 	// Adds a tooltip to the renderer.
 	void add_tooltip(glm::vec2 tl, std::string_view text_string);
 
-	// Draws everything drawn to blur_input() with a gaussian blur effect.
+	// Sets the quality of the blur effect.
+	void set_blur_quality(blur_quality quality);
+	// Draws everything drawn to blur_input() with a blur effect.
 	void draw_blurred(float saturation, float strength);
 	// Draws everything added to the renderer's layers.
 	void draw_layers(const tr::gfx::render_target& target);
@@ -106,15 +117,23 @@ class renderer {
 		tr::gfx::renderer_2d basic_renderer;
 		// Circle renderer.
 		tr::gfx::circle_renderer circle_renderer;
+		// Ball trail renderer.
+		trail_renderer trail_renderer;
 		// Blur renderer.
 		blur_renderer blur_renderer;
+		// Quality of the blur effect.
+		::blur_quality blur_quality;
+		// Glyph atlas.
+		glyph_atlas glyph_atlas;
+		// Number atlas.
+		number_atlas number_atlas;
 		// Tooltip manager.
 		tooltip_manager tooltip_manager;
 		// Optional extra components.
 		std::optional<extra> extra;
 
 		// Creates window-specific components.
-		window_specific_components(const settings& settings);
+		window_specific_components(const settings& settings, ::text_engine& text_engine);
 		// Destroys the window-specific components.
 		~window_specific_components();
 	};
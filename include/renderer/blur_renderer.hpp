@@ -1,11 +1,21 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                                                                                                                       //
 // Provides a renderer for drawing blurred and desaturated images.                                                                       //
-// 																																         //
+//                                                                                                                                       //
+// Two blur methods are available, selected by the blur quality setting. The high quality method is a two-pass separable gaussian done   //
+// at full resolution, whose cost grows linearly with the blur radius. The low quality method is a dual filter blur: the input is        //
+// repeatedly downsampled into a chain of half-sized textures and then upsampled back, with each pass taking a fixed number of           //
+// bilinearly-filtered taps, so that the cost stays roughly constant no matter the blur radius or screen size.                           //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
-#include "../global.hpp"
+#include "../settings.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Maximum number of downsampled textures used by the low quality blur.
+inline constexpr usize MAX_BLUR_LEVELS{5};
 
 ////////////////////////////////////////////////////////////// BLUR RENDERER //////////////////////////////////////////////////////////////
 
@@ -18,17 +28,26 @@ struct blur_renderer {
 	tr::gfx::render_target input();
 
 	// Draws the blurred version of the image last renderered onto input to the backbuffer.
-	void draw(const tr::gfx::render_target& screen, float saturation, float strength);
+	void draw(const tr::gfx::render_target& screen, float saturation, float strength, blur_quality quality);
 
   private:
 	// Texture used as the input in the drawing process.
 	tr::gfx::render_texture m_input_texture;
 	// Helper texture used during the rendering process.
 	tr::gfx::render_texture m_auxiliary_texture;
-	// Shader pipeline used by the blue renderer.
+	// Chain of progressively downsampled textures used by the low quality blur.
+	std::array<tr::gfx::render_texture, MAX_BLUR_LEVELS> m_levels;
+	// Shader pipeline used by the high quality blur.
 	tr::gfx::owning_shader_pipeline m_pipeline;
+	// Shader pipeline used by the low quality blur.
+	tr::gfx::owning_shader_pipeline m_dual_filter_pipeline;
 	// Vertex format used by the blur renderer.
 	tr::gfx::vertex_format m_vertex_format;
 	// Vertex buffer used by the blur renderer.
 	tr::gfx::static_vertex_buffer<glm::i8vec2> m_vertex_buffer;
+
+	// Draws the image using the high quality gaussian blur.
+	void draw_gaussian(const tr::gfx::render_target& screen, float saturation, float strength);
+	// Draws the image using the low quality dual filter blur.
+	void draw_dual_filter(const tr::gfx::render_target& screen, float saturation, float strength);
 };
\ No newline at end of file
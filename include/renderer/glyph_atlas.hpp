@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a shared atlas of rasterized glyphs used to draw UI text.                                                                    //
+//                                                                                                                                       //
+// Glyphs are rasterized once per font, style, pixel size and outline (as separate outline and fill bitmaps) and packed into rows of a   //
+// fixed-size texture. Text is laid out into glyph quads at the kerned positions measured by the text engine and added to the renderer   //
+// like any other textured mesh, outlines first and fills after, so changing a string only costs a layout instead of rasterizing and     //
+// uploading it again. When the atlas fills up or the fonts change, it is cleared and anything laid out before is invalidated.           //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "text_engine.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Width and height of the glyph atlas texture in pixels.
+inline constexpr int GLYPH_ATLAS_SIZE{2048};
+
+/////////////////////////////////////////////////////////////// GLYPH ATLAS ///////////////////////////////////////////////////////////////
+
+// Glyph positioned as part of laid out text.
+struct laid_out_glyph {
+	// The rectangle of the glyph's outline relative to the top-left corner of the text in pixels.
+	tr::frect2 outline_rect;
+	// The texture coordinates of the glyph's outline in the atlas.
+	tr::frect2 outline_uv;
+	// The rectangle of the glyph's fill relative to the top-left corner of the text in pixels.
+	tr::frect2 fill_rect;
+	// The texture coordinates of the glyph's fill in the atlas.
+	tr::frect2 fill_uv;
+};
+
+// String of text laid out as glyphs from the atlas.
+struct text_layout {
+	// The glyphs of the text.
+	std::vector<laid_out_glyph> glyphs;
+	// The size of the text in pixels.
+	glm::vec2 size;
+	// The generation of the atlas the text was laid out in.
+	u32 generation;
+};
+
+// Shared atlas of rasterized glyphs.
+class glyph_atlas {
+  public:
+	// Creates an empty glyph atlas.
+	glyph_atlas();
+
+	// Gets whether laid out text can still be drawn (the atlas wasn't cleared since it was laid out).
+	bool valid(const text_layout& layout) const;
+
+	// Lays out a string of text, rasterizing any glyphs that aren't in the atlas yet.
+	text_layout layout(text_engine& text_engine, const text& text, tr::halign align = tr::halign::LEFT);
+	// Adds laid out text to the renderer.
+	void add_to_renderer(tr::gfx::renderer_2d& renderer, int layer, const text_layout& layout, glm::vec2 tl, float scale,
+						 tr::rgba8 tint) const;
+
+  private:
+	// Locations of the parts of a glyph in the atlas texture.
+	struct atlas_glyph {
+		// The location of the glyph's outline.
+		tr::irect2 outline;
+		// The location of the glyph's fill.
+		tr::irect2 fill;
+	};
+
+	// The atlas texture.
+	tr::gfx::texture m_texture;
+	// The locations of the glyphs in the atlas texture, keyed by glyph_key().
+	std::unordered_map<u64, atlas_glyph> m_glyphs;
+	// The position the next glyph will be placed at.
+	glm::ivec2 m_next_pos;
+	// The height of the current row of glyphs.
+	int m_row_height;
+	// The number of times the atlas was cleared.
+	u32 m_generation;
+	// The font generation of the text engine the glyphs in the atlas were rasterized with.
+	u32 m_font_generation;
+
+	// Finds a glyph in the atlas, rasterizing and adding it first if needed.
+	atlas_glyph find_or_add(text_engine& text_engine, u32 glyph, const text& text, int scaled_size, int scaled_outline);
+	// Places a bitmap in the atlas, clearing it first if it's full.
+	tr::irect2 place(const tr::bitmap& bitmap);
+	// Clears the atlas.
+	void clear();
+};
\ No newline at end of file
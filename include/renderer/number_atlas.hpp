@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides an atlas of the digits and punctuation used by the game's timer and score displays.                                          //
+//                                                                                                                                       //
+// The characters are rendered with a gradient fill, which glyph_atlas doesn't support, so they are kept in an atlas of their own. It is //
+// built once when the window is opened and is owned by the window-specific components of the renderer, so it is only rebuilt when the   //
+// window is reopened (which is also the only time the rendering scale can change). Starting, restarting or copying a game thus does no  //
+// text rasterization or texture uploads.                                                                                                //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "text_engine.hpp"
+
+////////////////////////////////////////////////////////////// NUMBER ATLAS ///////////////////////////////////////////////////////////////
+
+// Sizes of the characters in a number atlas in field units.
+using number_sizes = std::array<glm::vec2, 12>;
+
+// Gets the size of a string of text in field units.
+glm::vec2 number_text_size(const number_sizes& sizes, std::string_view text, float scale);
+
+// Atlas of the characters used to display numbers in-game.
+class number_atlas {
+  public:
+	// Renders the characters at a rendering scale and builds the atlas.
+	number_atlas(text_engine& text_engine, float scale);
+
+	// Gets the sizes of the characters in field units.
+	const number_sizes& sizes() const;
+	// Adds a string of text to the renderer.
+	void add_to_renderer(tr::gfx::renderer_2d& renderer, int layer, std::string_view text, glm::vec2 tl, float scale, tr::rgba8 tint) const;
+
+  private:
+	// Sizes of the characters in field units (declared first, as they are filled in while the atlas is built).
+	number_sizes m_sizes;
+	// The atlas texture.
+	tr::gfx::dyn_atlas<char> m_atlas;
+};
\ No newline at end of file
@@ -5,7 +5,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
-#include "../global.hpp"
+#include "../lru_cache.hpp"
 
 /////////////////////////////////////////////////////////////// TEXT ENGINE ///////////////////////////////////////////////////////////////
 
@@ -37,6 +37,14 @@ struct text {
 	float max_width{tr::sys::UNLIMITED_WIDTH};
 };
 
+// Glyph rendered as separate outline and fill bitmaps.
+struct rendered_glyph {
+	// The outline of the glyph.
+	tr::bitmap outline;
+	// The fill of the glyph, to be drawn offset from the outline by the outline thickness.
+	tr::bitmap fill;
+};
+
 // Text engine class.
 class text_engine {
   public:
@@ -58,12 +66,54 @@ class text_engine {
 	glm::vec2 text_size(const text& text);
 	// Counts the number of lines in a string of text.
 	usize count_lines(const text& text);
+	// Splits a string of text into the lines it would be drawn as.
+	std::vector<std::string_view> split_lines(const text& text);
 	// Renders a string of text.
 	tr::bitmap render_text(const text& text, tr::halign align = tr::halign::LEFT);
-	// Renders a gradient-shaded glyph.
-	tr::bitmap render_gradient_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline);
+	// Gets the number of times the fonts were changed (anything rasterized under an older generation is stale).
+	u32 font_generation() const;
+	// Gets the pen positions of the glyphs of every line of a string of text including kerning, each followed by the width of the line.
+	std::vector<std::vector<int>> glyph_positions(const text& text);
+	// Renders an outlined glyph.
+	rendered_glyph render_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline);
+	// Renders a gradient-shaded glyph at a rendering scale.
+	tr::bitmap render_gradient_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline, float scale);
 
   private:
+	// Key identifying a string of text along with everything that affects its layout.
+	struct text_key {
+		// The text string.
+		std::string string;
+		// The font of the text.
+		font font;
+		// The font style of the text.
+		tr::sys::ttf_style style;
+		// The font size of the text.
+		float size;
+		// The thickness of the outline of the text.
+		float outline;
+		// The maximum width of a line of the text or UNLIMITED_WIDTH.
+		float max_width;
+		// The scale rendering was done at.
+		float scale;
+
+		// Compares two text keys.
+		bool operator==(const text_key&) const = default;
+	};
+	// Hasher for text keys.
+	struct text_key_hash {
+		// Hashes a text key.
+		usize operator()(const text_key& key) const;
+	};
+	// Cached layout of a string of text.
+	struct text_metrics {
+		// The size of the text when drawn.
+		glm::vec2 size;
+		// The lines the text is split into, as (offset, length) pairs into the string.
+		std::vector<std::pair<u32, u32>> lines;
+		// The pen positions of the glyphs of every line in pixels (without the outline), each followed by the width of the line.
+		std::vector<std::vector<int>> glyph_positions;
+	};
 	// Structure holding the standard fonts.
 	struct standard_fonts {
 		// Corresponds to font::DEFAULT.
@@ -106,7 +156,19 @@ class text_engine {
 	optional_font m_language_font;
 	// Additional language preview font.
 	optional_font m_language_preview_font;
+	// Cache of the fonts determined for strings, keyed by the preferred font (as the first character) followed by the string.
+	lru_cache<std::string, font> m_font_cache;
+	// Cache of line skips, keyed by the font (in the upper bits) and the bits of the scaled font size.
+	lru_cache<u64, float> m_line_skip_cache;
+	// Cache of text layouts.
+	lru_cache<text_key, text_metrics, text_key_hash> m_metrics_cache;
+	// The number of times the fonts were changed.
+	std::atomic<u32> m_font_generation{0};
 
 	// Converts a font name into an actual font reference.
 	tr::sys::ttfont& find_font(font font);
+	// Gets the layout of a string of text, measuring it if it isn't cached.
+	text_metrics metrics(const text& text);
+	// Clears all cached information and advances the font generation (after a font change).
+	void clear_caches();
 };
\ No newline at end of file
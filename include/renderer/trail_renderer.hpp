@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a renderer for drawing ball trails.                                                                                          //
+//                                                                                                                                       //
+// Each trail segment between two control points is a single instance. The vertex shader expands a unit quad into a rectangle around the //
+// segment, and the fragment shader cuts it down to a capsule and fades the opacity from one end to the other. The CPU only writes two   //
+// vectors per segment each frame, instead of building circle vertices and stitching indices for every control point.                    //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "../global.hpp"
+
+///////////////////////////////////////////////////////////// TRAIL RENDERER //////////////////////////////////////////////////////////////
+
+// Renderer for drawing ball trails.
+class trail_renderer {
+  public:
+	// Creates a trail renderer.
+	trail_renderer();
+
+	// Sets the transformation matrix.
+	void set_transform(const glm::mat4& mat);
+
+	// Adds a trail segment to the renderer.
+	void add_segment(glm::vec2 a, glm::vec2 b, float radius, float opacity_a, float opacity_b, float hue);
+
+	// Draws all added trail segments with max blending.
+	void draw(const tr::gfx::render_target& target);
+
+  private:
+	// Shader pipeline used by the trail renderer.
+	tr::gfx::owning_shader_pipeline m_pipeline;
+	// Vertex format used by the trail renderer.
+	tr::gfx::vertex_format m_vertex_format;
+	// Vertex buffer holding the quad expanded into every segment.
+	tr::gfx::static_vertex_buffer<glm::i8vec2> m_quad_buffer;
+	// Instance buffer holding the endpoints of the segments.
+	tr::gfx::dyn_vertex_buffer<glm::vec4> m_endpoint_buffer;
+	// Instance buffer holding the radii, endpoint opacities and hues of the segments.
+	tr::gfx::dyn_vertex_buffer<glm::vec4> m_parameter_buffer;
+	// The transformation matrix.
+	glm::mat4 m_transform;
+	// Endpoints of the segments added this frame.
+	std::vector<glm::vec4> m_endpoints;
+	// Radii, endpoint opacities and hues of the segments added this frame.
+	std::vector<glm::vec4> m_parameters;
+};
\ No newline at end of file
@@ -4,14 +4,38 @@
 //                                                                                                                                       //
 // Replays are loaded from replay files (a binary format) in <USER DIRECTORY>/replays which essentially contain a list of player inputs. //
 // They are very sensitive to desynchronisation because all the actual game logic is repeated on the viewing side, and even something    //
-// like compiling with the wrong compiler may return in miniscule gameplay differences that end up messing with replay playback.         //
-// All official builds of Bodge are compiled with Clang 20 to ensure replay coherency across operating systems and some versions.        //
+// like compiling with the wrong compiler may return in miniscule gameplay differences that end up messing with replay playback. Builds  //
+// made with BODGE_STRICT_FP (the default) use a simulation that is bit-reproducible across compilers (see game/sim_math.hpp), while     //
+// other builds are only compatible with builds made by the same compiler. The two kinds of builds use different replay versions, so     //
+// neither tries to play back the other's replays. Run Bodge with --conformance metadata/conformance_hashes.txt to check that a build    //
+// simulates games identically to the reference hashes.                                                                                  //
+//                                                                                                                                       //
+// Replay files are a version byte followed by a sequence of records, each separately encrypted and checksummed. Inputs are written in   //
+// fixed-size chunks while the game is being played and read back one chunk at a time during playback, so replays of any length take a   //
+// constant amount of memory. A preliminary header is written when recording starts and the final header is appended when the replay is  //
+// saved; the last valid header in a file is the one that's used, so a file left behind by a crash is still a playable (if incomplete)   //
+// replay.                                                                                                                               //
+//                                                                                                                                       //
+// Inputs are quantized to 1/64 of a field unit (active games are fed the quantized input as well) and stored as zigzag varint deltas,   //
+// which takes 2-4 bytes per input instead of 8.                                                                                         //
+//                                                                                                                                       //
+// A hash of the game's simulation state is recorded every STATE_HASH_INTERVAL inputs. Replay games compare the re-simulated state       //
+// against these during playback, so a desync is pinned down to the second it happened in instead of only showing up as a wrong final    //
+// score. Replays recorded before hashes were added simply aren't checked, and older builds skip the hash records.                       //
+//                                                                                                                                       //
+// The headers of the replays in a directory are cached in an index file (replays/index.bin) keyed by filename, modification time and    //
+// size, so listing replays only has to open files that were added or changed since the index was last written.                          //
 //                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 #include "score.hpp"
 
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Number of replay inputs between recorded hashes of the game state.
+inline constexpr usize STATE_HASH_INTERVAL{1_s};
+
 ////////////////////////////////////////////////////////////// REPLAY HEADER //////////////////////////////////////////////////////////////
 
 // Game replay header containing metadata.
@@ -37,19 +61,26 @@ template <> struct tr::binary_writer<replay_header> {
 // Game replay information.
 class replay {
   public:
-	// Creates an empty replay.
-	replay(std::string_view player, const gamemode& gamemode, u64 seed);
-	// Loads a replay from file.
+	// Starts recording a new replay in a directory.
+	replay(std::string_view player, const gamemode& gamemode, u64 seed,
+		   const std::filesystem::path& directory = debug_settings::instance().user_directory() / "replays");
+	// Opens a replay file for playback.
 	replay(const std::filesystem::path& path);
+	// Opens the file of another replay for playback.
 	replay(const replay& r);
-	replay(replay&&) noexcept = default;
+	// Move constructor.
+	replay(replay&& r) noexcept;
+	// Deletes the replay's file if it was being recorded and never saved.
+	~replay();
 
 	// Appends an input to the replay.
 	void append(glm::vec2 input);
+	// Appends a hash of the game state after the last appended input (expected every STATE_HASH_INTERVAL inputs).
+	void append_state_hash(u64 hash);
 	// Sets the replay's header.
 	void set_header(const score_entry& score, std::string_view name);
-	// Saves the replay to a file based on its name.
-	void save_to_directory(const std::filesystem::path& directory = debug_settings::instance().user_directory() / "replays") const;
+	// Finishes recording the replay and moves it to a file based on its name.
+	void save_to_directory(const std::filesystem::path& directory = debug_settings::instance().user_directory() / "replays");
 
 	// Gets the replay's header.
 	const replay_header& header() const;
@@ -59,17 +90,55 @@ class replay {
 	glm::vec2 next_input();
 	// Gets the previous input in the replay.
 	glm::vec2 prev_input() const;
+	// Gets the number of inputs that have been read.
+	usize position() const;
+	// Moves to an input that has already been reached before.
+	void seek(usize position);
+	// Gets the recorded hash of the game state after a number of inputs (if one was recorded).
+	std::optional<u64> state_hash(usize position) const;
 
   private:
 	// The replay's header.
 	replay_header m_header;
-	// List of player inputs.
-	std::vector<glm::vec2> m_inputs;
-	// Iterator to the next input to return.
-	std::vector<glm::vec2>::iterator m_next_it;
+	// The path to the replay's file.
+	std::filesystem::path m_path;
+	// The file being recorded to.
+	std::ofstream m_ofile;
+	// The file being played back from.
+	std::ifstream m_ifile;
+	// Offsets of the chunks in the file that have been reached so far.
+	std::vector<std::streampos> m_chunk_offsets;
+	// The index of the next chunk to be read.
+	usize m_next_chunk;
+	// Whether the replay is being recorded and hasn't been saved yet.
+	bool m_unsaved;
+	// The current chunk of inputs (inputs that haven't been written yet when recording).
+	std::vector<glm::vec2> m_chunk;
+	// Index of the next input to return in the current chunk.
+	usize m_next_input;
+	// The number of inputs that have been read (or appended when recording).
+	usize m_position;
+	// The last returned input.
+	glm::vec2 m_prev_input;
+	// Hashes of the game state recorded every STATE_HASH_INTERVAL inputs (hashes that haven't been written yet when recording).
+	std::vector<u64> m_state_hashes;
+	// The number of state hashes that have been written to the file.
+	usize m_written_state_hashes;
+	// Buffer reused for encoding records while recording.
+	std::string m_encoded_record;
+	// Buffer reused for encrypting records while recording.
+	std::vector<std::byte> m_encrypted_record;
+
+	// Writes the current chunk and any unwritten state hashes to the file and clears the chunk.
+	void write_chunk();
+	// Reads the next chunk from the file, leaving the current chunk empty if there is none.
+	void read_chunk();
 };
 
+// Quantizes an input to the precision it is stored at in replays.
+glm::vec2 quantize_replay_input(glm::vec2 input);
+
 // Map of available replays.
 using replay_map = std::map<std::filesystem::path, replay_header>;
-// Loads all available replay headers.
+// Loads all available replay headers, using and updating the directory's header index.
 replay_map load_replay_headers(const std::filesystem::path& directory = debug_settings::instance().user_directory() / "replays");
\ No newline at end of file
@@ -4,11 +4,31 @@
 //                                                                                                                                       //
 // The savefile is loaded from and saved to <USER DIRECTORY>/scorefile.dat (a binary file) and contains all player data.                 //
 //                                                                                                                                       //
+// The savefile is memory-mapped (see mapped_file.hpp) and starts with a small encrypted block holding the player's name, playtime,      //
+// drafts and an offset table of the score categories. The score entries themselves are stored after it in fixed-size tables that are    //
+// only read when they are accessed, with their descriptions stored out-of-line as variable-length strings, so loading the savefile (and //
+// copying it, as the mapping is shared) takes the same time no matter how many runs it holds. The tables and descriptions aren't        //
+// encrypted, so the offset table also holds a keyed checksum of every category's entries, which is verified the first time the          //
+// category's entries are accessed. Savefiles are written to a temporary file that then replaces the old one, so the mapping of the old  //
+// file stays valid while the new one is written.                                                                                        //
+//                                                                                                                                       //
+// While the game runs, a single savefile is shared by all states through the savefile service. States hold immutable snapshots of it,   //
+// and modifications are made to a copy that then replaces the shared savefile, after which it is written to disk in the background.     //
+// Writes are done in the order the modifications were made.                                                                             //
+//                                                                                                                                       //
+// Adding a score doesn't rewrite the savefile: the new entry is instead appended to a journal (<USER DIRECTORY>/savefile.dat.journal)   //
+// as a record with a keyed checksum, which is replayed when the savefile is loaded. Once the journal holds enough entries, it is        //
+// compacted by writing out the full savefile. A torn record at the end of the journal is simply dropped, and a journal left over from   //
+// an interrupted compaction is recognized by its identifier and ignored.                                                                //
+//                                                                                                                                       //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 #include "gamemode.hpp"
+#include "mapped_file.hpp"
 #include "settings.hpp"
+#include <future>
+#include <mutex>
 
 /////////////////////////////////////////////////////////////// SCORE FLAGS ///////////////////////////////////////////////////////////////
 
@@ -44,33 +64,8 @@ template <> struct tr::binary_writer<score_entry> {
 	static void write_to_stream(std::ostream& os, const score_entry& in);
 };
 
-// Compares score entries by score.
-bool compare_scores(const score_entry& l, const score_entry& r);
-// Compares score entries by time.
-bool compare_times(const score_entry& l, const score_entry& r);
-
 ///////////////////////////////////////////////////////////// SCORE CATEGORY //////////////////////////////////////////////////////////////
 
-// Collection of scores played on a specific gamemode.
-struct score_category {
-	// The gamemode the scores were played on.
-	gamemode gamemode;
-	// Cached best score result.
-	i64 best_score;
-	// Cached best time result.
-	ticks best_time;
-	// List of score entries.
-	std::vector<score_entry> entries;
-};
-template <> struct tr::binary_reader<score_category> {
-	static std::span<const std::byte> read_from_span(std::span<const std::byte> span, score_category& out);
-};
-template <> struct tr::binary_writer<score_category> {
-	static void write_to_stream(std::ostream& os, const score_category& in);
-};
-
-///////////////////////////////////////////////////////////////// SAVEFILE ////////////////////////////////////////////////////////////////
-
 // Structure returned by savefile::best_results() containing the best results for a given category.
 struct best_results {
 	// The best score result.
@@ -79,14 +74,75 @@ struct best_results {
 	ticks time;
 };
 
+// Collection of scores played on a specific gamemode.
+class score_category {
+  public:
+	// Creates an empty score category.
+	score_category(const ::gamemode& gamemode);
+	// Creates a score category whose entries are stored in a mapped savefile.
+	score_category(const ::gamemode& gamemode, ::best_results best_results, std::shared_ptr<const mapped_file> file,
+				   std::span<const std::byte> entry_table, std::span<const std::byte> descriptions, u64 checksum);
+
+	// Gets the cached best results.
+	::best_results best_results() const;
+	// Gets the number of score entries.
+	usize size() const;
+	// Loads a score entry.
+	score_entry operator[](usize index) const;
+	// Gets the indices of the score entries sorted from the highest to the lowest score.
+	std::vector<usize> ranked_by_score() const;
+	// Gets the indices of the score entries sorted from the longest to the shortest time.
+	std::vector<usize> ranked_by_time() const;
+
+	// Adds a score entry.
+	void add(const score_entry& entry);
+
+	// The gamemode the scores were played on.
+	::gamemode gamemode;
+
+  private:
+	// Result of verifying the stored entries of a category.
+	struct integrity_check {
+		// Flag ensuring the entries are only verified once.
+		std::once_flag flag;
+		// Whether the entries matched their checksum.
+		bool valid{false};
+	};
+
+	// Cached best results.
+	::best_results m_best_results;
+	// The mapped savefile holding the stored entries (null if there are none).
+	std::shared_ptr<const mapped_file> m_file;
+	// Table of the stored entries (excluding descriptions).
+	std::span<const std::byte> m_entry_table;
+	// The descriptions of the stored entries.
+	std::span<const std::byte> m_descriptions;
+	// Keyed checksum of the stored entries and their descriptions.
+	u64 m_checksum{0};
+	// Result of verifying the stored entries, shared by all copies of the category (null if there are no stored entries).
+	std::shared_ptr<integrity_check> m_check;
+	// Entries added since the savefile was loaded.
+	std::vector<score_entry> m_added_entries;
+
+	// Gets the score and time of an entry without loading the rest of it.
+	::best_results results(usize index) const;
+	// Gets the table of the stored entries, verifying it on first access (empty if it didn't match its checksum).
+	std::span<const std::byte> stored_entries() const;
+};
+
+///////////////////////////////////////////////////////////////// SAVEFILE ////////////////////////////////////////////////////////////////
+
 // Savefile information.
 class savefile {
   public:
 	// Loads a savefile.
 	savefile(const std::filesystem::path& path = debug_settings::instance().user_directory() / "savefile.dat");
 
-	// Saves the savefile.
-	void save_to_file(const std::filesystem::path& path = debug_settings::instance().user_directory() / "savefile.dat");
+	// Saves the savefile, compacting its journal into it.
+	void save_to_file(const std::filesystem::path& path = debug_settings::instance().user_directory() / "savefile.dat") const;
+	// Appends a score entry to the savefile's journal.
+	void append_to_journal(const gamemode& gm, const score_entry& s,
+						   const std::filesystem::path& path = debug_settings::instance().user_directory() / "savefile.dat") const;
 
 	// Gets whether the savefile is unnamed.
 	bool unnamed() const;
@@ -111,10 +167,59 @@ class savefile {
 	gamemode last_selected_gamemode;
 
   private:
+	// Loads the score categories and player data from a mapped savefile.
+	void load(std::shared_ptr<const mapped_file> file, std::span<const std::byte> data);
+	// Loads a savefile in the old format where all entries were stored in one encrypted block.
+	void load_legacy(std::span<const std::byte> data);
+	// Replays the score entries recorded in the savefile's journal.
+	void load_journal(const std::filesystem::path& path);
+	// Starts a new journal, invalidating the old one.
+	void start_new_journal();
+
 	// Savefile name.
 	tr::static_string<20 * 4> m_name{};
 	// List of score categories.
 	std::vector<score_category> m_score_categories;
 	// Total playtime.
 	ticks m_playtime{0};
+	// Identifier tying the journal to the savefile it was started for.
+	u64 m_journal_id{0};
+	// The number of score entries in the journal.
+	usize m_journal_size{0};
+
+	friend class savefile_service;
+};
+
+//////////////////////////////////////////////////////////// SAVEFILE SERVICE /////////////////////////////////////////////////////////////
+
+// Immutable snapshot of the savefile.
+using savefile_snapshot = std::shared_ptr<const savefile>;
+
+// Shared savefile that hands out snapshots and writes changes back to disk in the background.
+class savefile_service {
+  public:
+	// Loads the savefile.
+	savefile_service(const std::filesystem::path& path = debug_settings::instance().user_directory() / "savefile.dat");
+	// Waits for pending writes to finish.
+	~savefile_service();
+
+	// Gets a snapshot of the current savefile.
+	savefile_snapshot snapshot() const;
+	// Applies a modification to a copy of the current savefile, publishes it and queues it to be written, returning the new snapshot.
+	savefile_snapshot modify(const std::function<void(savefile&)>& modification);
+	// Adds a score entry to a copy of the current savefile, publishes it and queues the entry to be journaled, returning the new snapshot.
+	savefile_snapshot add_score(const gamemode& gm, const score_entry& s);
+
+  private:
+	// Path to the savefile.
+	std::filesystem::path m_path;
+	// Mutex protecting the current snapshot and the pending write.
+	mutable std::mutex m_mutex;
+	// The current snapshot.
+	savefile_snapshot m_current;
+	// The last queued write (writes wait on the one before them, so they land in order).
+	std::future<void> m_pending_write;
+
+	// Queues a write to be done after the pending one.
+	void queue_write(std::function<void()> write);
 };
\ No newline at end of file
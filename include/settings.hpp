@@ -43,6 +43,28 @@ class debug_settings {
 	bool modified_game_speed() const;
 	// Gets whether to display performance statistics.
 	bool show_performance_overlay() const;
+	// Gets the directory of replays to verify headlessly (empty if not verifying replays).
+	const std::filesystem::path& replay_verification_directory() const;
+	// Gets whether to run the simulation benchmarks.
+	bool run_benchmarks() const;
+	// Gets the path to the reference hashes of the simulation conformance check (empty if not running it).
+	const std::filesystem::path& conformance_reference() const;
+	// Gets whether to record the reference hashes of the conformance check instead of checking against them.
+	bool record_conformance_reference() const;
+	// Gets whether to run the simulation allocation check.
+	bool run_allocation_check() const;
+	// Gets the path to the gamemode to run a batch simulation of (empty if not running one).
+	const std::filesystem::path& batch_simulation_gamemode() const;
+	// Gets the first seed used in the batch simulation.
+	u64 batch_simulation_first_seed() const;
+	// Gets the number of games run in the batch simulation.
+	usize batch_simulation_game_count() const;
+	// Gets the name of the input policy used in the batch simulation.
+	const std::string& batch_simulation_policy() const;
+	// Gets the number of minutes of game time to run the soak test for (0 if not running it).
+	usize soak_test_minutes() const;
+	// Gets the directory the soak test saves the replays of finished games to.
+	const std::filesystem::path& soak_test_replay_directory() const;
 
   private:
 	// Path to the program data directory.
@@ -55,6 +77,28 @@ class debug_settings {
 	float m_game_speed{1.0f};
 	// Whether to display performance statistics.
 	bool m_show_perf{BODGE_SHOW_PERF_DEFAULT};
+	// Directory of replays to verify headlessly.
+	std::filesystem::path m_replay_verification_directory;
+	// Whether to run the simulation benchmarks.
+	bool m_run_benchmarks{false};
+	// Path to the reference hashes of the simulation conformance check.
+	std::filesystem::path m_conformance_reference;
+	// Whether to record the reference hashes of the conformance check instead of checking against them.
+	bool m_record_conformance_reference{false};
+	// Whether to run the simulation allocation check.
+	bool m_run_allocation_check{false};
+	// Path to the gamemode to run a batch simulation of.
+	std::filesystem::path m_batch_simulation_gamemode;
+	// The first seed used in the batch simulation.
+	u64 m_batch_simulation_first_seed{0};
+	// The number of games run in the batch simulation.
+	usize m_batch_simulation_game_count{1000};
+	// The name of the input policy used in the batch simulation.
+	std::string m_batch_simulation_policy{"scripted"};
+	// The number of minutes of game time to run the soak test for.
+	usize m_soak_test_minutes{0};
+	// The directory the soak test saves the replays of finished games to.
+	std::filesystem::path m_soak_test_replay_directory;
 
 	// Constructs default command-line argumnt settings.
 	debug_settings() = default;
@@ -73,6 +117,12 @@ enum class display_mode : bool {
 	FULLSCREEN
 };
 
+// Quality of the menu background blur.
+enum class blur_quality : bool {
+	HIGH,
+	LOW
+};
+
 // Sentinel denoting that multisampling is disabled.
 constexpr u8 NO_MSAA{0};
 
@@ -84,6 +134,8 @@ struct settings {
 	display_mode display_mode{display_mode::WINDOWED};
 	// Whether V-sync is enabled.
 	bool vsync{false};
+	// Quality of the menu background blur.
+	blur_quality blur_quality{blur_quality::HIGH};
 	// Mouse sensitivity as a percentage.
 	u8 mouse_sensitivity{100};
 	// Active player skin (or empty string for none).
@@ -24,6 +24,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include "game_thread.hpp"
 #include "state/state_base.hpp"
 
 using gamemode_widget_action_command = std::function<void(const gamemode_with_path&)>;
@@ -45,11 +46,19 @@ class current_state : public tr::state_machine {
 	tr::sys::signal handle_event(const tr::sys::event& event);
 	// Updates the state and returns a signal.
 	tr::sys::signal tick();
+	// Gets whether a frame drawn now could differ from the last drawn one.
+	bool redraw_needed();
+	// Draws the state.
+	void draw();
 
   private:
+	using state_machine::draw;
 	using state_machine::handle_event;
 	using state_machine::tick;
 
+	// Whether an event or tick happened since the last drawn frame.
+	bool m_redraw_needed{true};
+
 	// Creates an initial state.
 	current_state();
 };
@@ -145,9 +154,7 @@ class title_state final : public main_menu_state {
 class start_game_state final : public main_menu_state {
   public:
 	// Creates a start game state.
-	start_game_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile savefile);
-	// Destroys the state.
-	~start_game_state() override;
+	start_game_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile_snapshot savefile);
 
 	// Signals whether the cursor should be drawn transparent.
 	bool transparent_cursor() const override;
@@ -171,8 +178,8 @@ class start_game_state final : public main_menu_state {
 
 	// The current substate.
 	substate m_substate;
-	// Cached copy of the savefile.
-	savefile m_savefile;
+	// Snapshot of the savefile.
+	savefile_snapshot m_savefile;
 	// List of available gamemodes.
 	std::vector<gamemode_with_path> m_gamemodes;
 	// The currently selected gamemode.
@@ -185,6 +192,8 @@ class start_game_state final : public main_menu_state {
 
 	// Sets up the UI exit animation.
 	void set_up_exit_animation();
+	// Stores the selected gamemode in the savefile so that it is selected again next time.
+	void remember_selected_gamemode();
 
 	// Function called when the "previous gamemode" arrow is pressed.
 	void on_previous_gamemode();
@@ -239,19 +248,12 @@ class gamemode_manager_state final : public main_menu_state {
 // Data specific to a new gamemode editor.
 class new_gamemode_editor {
   public:
-	// Constructs new gamemode editor data.
-	new_gamemode_editor(savefile savefile);
-
 	// Gets the text command used for the subtitle of the gamemode editor.
 	localized_text subtitle_text(const localization& localization) const;
 	// Function called by the gamemode editor state on save.
 	void on_save(gamemode_editor_state& state);
 	// Function called by the gamemode editor state on discard.
 	void on_discard(gamemode_editor_state& state);
-
-  private:
-	// Cached copy of the savefile.
-	savefile m_savefile{};
 };
 // Data specific to a cloned gamemode editor.
 class cloned_gamemode_editor {
@@ -500,6 +502,7 @@ class gamemode_selector_state final : public main_menu_state {
 
 	// Prepares the widgets for the next page.
 	std::unordered_map<tag, std::unique_ptr<widget>> prepare_next_widgets();
+
 	// Sets up the UI page switching animation.
 	void set_up_page_switch_animation();
 	// Sets up the UI exit animation.
@@ -525,7 +528,7 @@ class gamemode_selector_state final : public main_menu_state {
 class scoreboard_selection_state final : public main_menu_state {
   public:
 	// Creates a scoreboard selection state.
-	scoreboard_selection_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile savefile,
+	scoreboard_selection_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile_snapshot savefile,
 							   animate_title animate_title);
 
 	// Updates the state.
@@ -542,8 +545,8 @@ class scoreboard_selection_state final : public main_menu_state {
 
 	// The current substate.
 	substate m_substate;
-	// Cached copy of the savefile.
-	savefile m_savefile;
+	// Snapshot of the savefile.
+	savefile_snapshot m_savefile;
 
 	// Sets up the UI exit animation.
 	void set_up_exit_animation(animate_title animate_title);
@@ -568,7 +571,7 @@ enum class scoreboard {
 class scoreboard_state final : public main_menu_state {
   public:
 	// Creates a scoreboard state.
-	scoreboard_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile savefile,
+	scoreboard_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile_snapshot savefile,
 					 scoreboard scoreboard);
 
 	// Updates the state.
@@ -591,15 +594,20 @@ class scoreboard_state final : public main_menu_state {
 	scoreboard m_scoreboard;
 	// The currently open page.
 	int m_page;
-	// Cached copy of the savefile.
-	savefile m_savefile;
+	// Snapshot of the savefile.
+	savefile_snapshot m_savefile;
 	// The currently selected gamemode.
 	std::vector<score_category>::const_iterator m_selected;
-	// List of scores sorted by either score or time depending on the scoreboard.
-	std::vector<score_entry> m_sorted_scores;
+	// Indices of the selected gamemode's scores sorted by either score or time depending on the scoreboard.
+	std::vector<usize> m_ranking;
 	// Holds the result of an asynchronously loaded new set of widgets.
 	std::future<std::unordered_map<tag, std::unique_ptr<widget>>> m_next_widgets;
 
+	// Ranks the scores of the selected gamemode.
+	void rank_scores();
+	// Loads the scores shown on the current page.
+	std::vector<score_entry> load_page() const;
+
 	// Sets up the UI page switching animation.
 	void set_up_page_switch_animation();
 	// Sets up the UI exit animation.
@@ -777,6 +785,8 @@ class game_state final : public state {
 
 	// Signals whether the cursor should be drawn transparent.
 	bool transparent_cursor() const override;
+	// Signals whether the state draws interpolated frames, which differ even if no tick happened between them.
+	bool interpolates_frames() const override;
 	// Handles an event.
 	tr::next_state handle_event(const tr::sys::event& event) override;
 	// Updates the state.
@@ -805,9 +815,15 @@ class game_state final : public state {
 	float m_song_speed;
 	// Pointer to the game being played.
 	std::shared_ptr<game> m_game;
+	// Thread simulating the game while it's ongoing (the game is only touched directly while this is empty).
+	std::optional<game_thread> m_game_thread;
+	// The replay desync shown next to the replay label (if any was detected).
+	std::optional<usize> m_shown_desync;
 
 	// Calculates the opacity of the fade overlay.
 	float fade_overlay_opacity() const;
+	// Shows the first desync of the played back replay in the UI if it changed since it was last shown.
+	void show_replay_desync_if_needed();
 
 	// Sets the song of the playing speed if needed.
 	void set_song_speed_if_needed(float speed);
@@ -840,7 +856,7 @@ enum class blur_in : bool {
 class pause_state final : public game_menu_state {
   public:
 	// Creates a test game pause state.
-	pause_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, game_state_data data,
+	pause_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile, game_state_data data,
 				glm::vec2 mouse_pos, blur_in blur_in);
 
 	// Signals whether the cursor should be drawn transparent.
@@ -906,7 +922,7 @@ class pause_state final : public game_menu_state {
 class game_over_state final : public game_menu_state {
   public:
 	// Creates a game over state.
-	game_over_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, blur_in blur_in);
+	game_over_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile, blur_in blur_in);
 
 	// Signals whether the cursor should be drawn transparent.
 	bool transparent_cursor() const override;
@@ -971,10 +987,11 @@ DEFINE_BITMASK_OPERATORS(save_screen_flags);
 class save_score_state final : public game_menu_state {
   public:
 	// Creates a save score state coming from the pause screen.
-	save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, glm::vec2 mouse_pos,
+	save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile, glm::vec2 mouse_pos,
 					 save_screen_flags flags);
 	// Creates a save score state coming from the game over screen.
-	save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, save_screen_flags flags);
+	save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
+					 save_screen_flags flags);
 
 	// Updates the state.
 	tr::next_state tick() override;
@@ -1022,7 +1039,8 @@ class save_score_state final : public game_menu_state {
 class save_replay_state final : public game_menu_state {
   public:
 	// Creates the save replay state.
-	save_replay_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, save_screen_flags flags);
+	save_replay_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
+					  save_screen_flags flags);
 
 	// Signals whether the cursor should be drawn transparent.
 	bool transparent_cursor() const override;
@@ -10,6 +10,24 @@
 #include "../ui.hpp"
 #include <future>
 
+///////////////////////////////////////////////////////////// LIVE EVENT SINK /////////////////////////////////////////////////////////////
+
+// Game event sink that forwards events to the audio manager and renderer.
+class live_event_sink : public game_event_sink {
+  public:
+	// Gets the live event sink instance.
+	static live_event_sink& instance();
+
+	// Plays a sound effect through the audio manager.
+	void play_sound(sound sound, float volume, float pan, float pitch = 1) override;
+	// Shakes the screen by offsetting the renderer's default transform.
+	void shake_screen(glm::vec2 offset) override;
+
+  private:
+	// Constructs the live event sink.
+	live_event_sink() = default;
+};
+
 ////////////////////////////////////////////////////////////////// STATE //////////////////////////////////////////////////////////////////
 
 // Base class for all states.
@@ -26,6 +44,8 @@ class state : public tr::state {
 		input input;
 		// Localization manager.
 		localization localization;
+		// Shared savefile.
+		savefile_service savefile_service;
 	};
 
 	// Creates a state with an associated selection tree and shortcut table.
@@ -33,6 +53,8 @@ class state : public tr::state {
 
 	// Signals whether the cursor should be drawn transparent.
 	virtual bool transparent_cursor() const;
+	// Signals whether the state draws interpolated frames, which differ even if no tick happened between them.
+	virtual bool interpolates_frames() const;
 	// Handles an event.
 	tr::next_state handle_event(const tr::sys::event& event) override;
 	// Updates the state.
@@ -102,7 +124,7 @@ class game_menu_state : public state {
   public:
 	// Creates a game menu state.
 	game_menu_state(std::shared_ptr<subsystems> subsystems, selection_tree selection_tree, shortcut_table shortcuts,
-					std::shared_ptr<game> game, savefile savefile, update_game update_game);
+					std::shared_ptr<game> game, savefile_snapshot savefile, update_game update_game);
 
 	// Updates the state.
 	tr::next_state tick() override;
@@ -112,8 +134,8 @@ class game_menu_state : public state {
   protected:
 	// Background game.
 	std::shared_ptr<game> m_game;
-	// Cached copy of the savefile.
-	savefile m_savefile;
+	// Snapshot of the savefile.
+	savefile_snapshot m_savefile;
 
   private:
 	// Flag denoting whether to update the game in the background.
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Provides a lock-free triple buffer for handing values from one producer thread to one consumer thread.                                //
+//                                                                                                                                       //
+// The producer always writes into a back buffer nobody else touches and then swaps it with the middle buffer. The consumer swaps the    //
+// middle buffer with its front buffer only when something new was published. Neither side ever waits for the other, the producer can    //
+// overwrite values the consumer never saw, and the consumer always reads the most recently published value. The buffers are only ever   //
+// swapped, never reconstructed, so values can be written into them in place and keep whatever they already own.                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "global.hpp"
+#include <atomic>
+
+////////////////////////////////////////////////////////////// TRIPLE BUFFER //////////////////////////////////////////////////////////////
+
+// Single-producer, single-consumer lock-free triple buffer.
+template <class T> class triple_buffer {
+  public:
+	// Creates a triple buffer with all three buffers constructed from the same arguments.
+	template <class... Args> triple_buffer(const Args&... args);
+
+	// Gets the buffer the producer writes into.
+	T& write_buffer();
+	// Publishes the write buffer to the consumer (producer only).
+	void publish();
+
+	// Fetches the latest published value if there is one and returns whether it did (consumer only).
+	bool update();
+	// Gets the buffer the consumer reads from.
+	const T& read_buffer() const;
+
+  private:
+	// Flag set in the middle index when it holds a value the consumer hasn't fetched yet.
+	static constexpr u8 DIRTY{0b100};
+
+	// The three buffers.
+	std::array<T, 3> m_buffers;
+	// Index of the buffer owned by the producer.
+	u8 m_back{0};
+	// Index of the buffer in transit between the threads, with the dirty flag.
+	std::atomic<u8> m_middle{1};
+	// Index of the buffer owned by the consumer.
+	u8 m_front{2};
+};
+
+///////////////////////////////////////////////////////////// IMPLEMENTATION //////////////////////////////////////////////////////////////
+
+template <class T>
+template <class... Args>
+triple_buffer<T>::triple_buffer(const Args&... args)
+	: m_buffers{T{args...}, T{args...}, T{args...}}
+{
+}
+
+template <class T> T& triple_buffer<T>::write_buffer()
+{
+	return m_buffers[m_back];
+}
+
+template <class T> void triple_buffer<T>::publish()
+{
+	m_back = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel) & ~DIRTY;
+}
+
+template <class T> bool triple_buffer<T>::update()
+{
+	if (!(m_middle.load(std::memory_order_relaxed) & DIRTY)) {
+		return false;
+	}
+	m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & ~DIRTY;
+	return true;
+}
+
+template <class T> const T& triple_buffer<T>::read_buffer() const
+{
+	return m_buffers[m_front];
+}
\ No newline at end of file
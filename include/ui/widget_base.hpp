@@ -184,13 +184,13 @@ class text_widget : public widget {
 	text_command m_text;
 	// The last drawn string.
 	mutable std::string m_last_text;
-	// Cached resources.
-	mutable std::variant<std::monostate, tr::bitmap, tr::gfx::texture> m_cache;
+	// Layout of the last drawn string in the renderer's glyph atlas (empty until first drawn).
+	mutable std::optional<text_layout> m_layout;
 	// The size of the last drawn string.
 	mutable glm::vec2 m_last_size;
 
-	// Updates the text cache.
-	void update_cache(text_engine& text_engine) const;
+	// Updates the text layout.
+	void update_layout(renderer& renderer) const;
 	// Adds the widget to the renderer (must be further specialized by descendant classes).
 	void add_to_renderer_raw(renderer& renderer, tr::rgba8 tint);
 };
@@ -7,6 +7,33 @@
 #include "../include/audio.hpp"
 #include "../include/settings.hpp"
 
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Priorities of the sound effects (a voice playing a sound effect can't be stolen by a sound effect with a lower priority).
+constexpr std::array<int, int(sound::COUNT)> SOUND_PRIORITIES{
+	1, // HOVER
+	1, // HOLD
+	2, // CONFIRM
+	2, // CANCEL
+	1, // TYPE
+	3, // PAUSE
+	3, // UNPAUSE
+	2, // TICK
+	2, // TICK_ALT
+	1, // BALL_SPAWN
+	0, // BOUNCE
+	1, // STYLE
+	2, // FRAGMENT_SPAWN
+	2, // COLLECT
+	4, // ONE_UP
+	4, // HIT
+	4, // GAME_OVER
+};
+// The highest sound effect priority.
+constexpr int MAX_SOUND_PRIORITY{4};
+// Time after which a voice is considered free (no sound effect is longer than this).
+constexpr std::chrono::steady_clock::duration MAX_SOUND_LENGTH{3s};
+
 ///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
 
 // Tries to find a path to a song given a filename.
@@ -70,6 +97,16 @@ audio::audio(const settings& settings)
 		}
 		m_current_song.emplace(1000);
 		m_current_song->set_classes(2);
+		// If the audio device doesn't support as many sources, the voices that couldn't be allocated are left unused.
+		try {
+			for (voice& voice : m_voices) {
+				voice.source.emplace(0);
+				voice.source->set_classes(1);
+				voice.source->set_rolloff(1.0f);
+			}
+		}
+		catch (tr::exception&) {
+		}
 	}
 	catch (tr::audio::init_error&) {
 		return;
@@ -80,6 +117,9 @@ audio::~audio()
 {
 	if (tr::audio::active()) {
 		m_current_song.reset();
+		for (voice& voice : m_voices) {
+			voice.source.reset();
+		}
 		for (std::optional<tr::audio::buffer>& sound : m_sounds) {
 			sound.reset();
 		}
@@ -107,16 +147,24 @@ void audio::set_volume(float sfx_volume, float music_volume)
 
 void audio::play_sound(sound sound, float volume, float pan, float pitch)
 {
-	if (tr::audio::active() && m_sounds[int(sound)].has_value()) {
-		std::optional<tr::audio::source> source{tr::audio::try_allocating_source(0)};
-		if (source.has_value()) {
-			source->use(*m_sounds[int(sound)]);
-			source->set_classes(1);
-			source->set_gain(volume * 0.75f);
-			source->set_pitch(pitch);
-			source->set_pos({tr::magth(1.0f, tr::acos(pan)), 0});
-			source->set_rolloff(1.0f);
-			source->play();
+	queued_sound& queued{m_queued_sounds[int(sound)]};
+	++queued.count;
+	queued.loudest = std::max(queued.loudest, volume);
+	queued.total_volume += volume;
+	queued.weighted_pan += pan * volume;
+	queued.weighted_pitch += pitch * volume;
+}
+
+void audio::dispatch_queued_sounds()
+{
+	const std::chrono::steady_clock::time_point now{std::chrono::steady_clock::now()};
+	// More important sound effects are played first so that they get to pick their voices first.
+	for (int priority = MAX_SOUND_PRIORITY; priority >= 0; --priority) {
+		for (int i = 0; i < int(sound::COUNT); ++i) {
+			if (SOUND_PRIORITIES[i] == priority && m_queued_sounds[i].count != 0) {
+				play_queued_sound(sound(i), m_queued_sounds[i], now);
+				m_queued_sounds[i] = {};
+			}
 		}
 	}
 }
@@ -177,4 +225,50 @@ void audio::fade_song_out(tr::fsecs time)
 	if (m_current_song.has_value()) {
 		m_current_song->set_gain(0, time);
 	}
+}
+
+//
+
+audio::voice* audio::pick_voice(int priority, std::chrono::steady_clock::time_point now)
+{
+	voice* picked{nullptr};
+	int picked_priority{0};
+	for (voice& voice : m_voices) {
+		if (!voice.source.has_value()) {
+			continue;
+		}
+
+		// Voices that have been playing for longer than any sound effect lasts are free.
+		const int voice_priority{now - voice.start >= MAX_SOUND_LENGTH ? -1 : voice.priority};
+		if (voice_priority <= priority &&
+			(picked == nullptr || voice_priority < picked_priority || (voice_priority == picked_priority && voice.start < picked->start))) {
+			picked = &voice;
+			picked_priority = voice_priority;
+		}
+	}
+	return picked;
+}
+
+void audio::play_queued_sound(sound sound, const queued_sound& queued, std::chrono::steady_clock::time_point now)
+{
+	if (!tr::audio::active() || !m_sounds[int(sound)].has_value()) {
+		return;
+	}
+
+	voice* voice{pick_voice(SOUND_PRIORITIES[int(sound)], now)};
+	if (voice == nullptr) {
+		return;
+	}
+
+	const float volume{std::min(queued.total_volume, queued.loudest * MAX_MERGED_VOLUME_GAIN)};
+	const float pan{queued.total_volume > 0 ? queued.weighted_pan / queued.total_volume : 0.0f};
+	const float pitch{queued.total_volume > 0 ? queued.weighted_pitch / queued.total_volume : 1.0f};
+	voice->source->stop();
+	voice->source->use(*m_sounds[int(sound)]);
+	voice->source->set_gain(volume * 0.75f);
+	voice->source->set_pitch(pitch);
+	voice->source->set_pos({tr::magth(1.0f, tr::acos(std::clamp(pan, -1.0f, 1.0f))), 0});
+	voice->source->play();
+	voice->priority = SOUND_PRIORITIES[int(sound)];
+	voice->start = now;
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "../include/game.hpp"
-#include "../include/audio.hpp"
+#include "../include/game/sim_math.hpp"
 #include "../include/input.hpp"
 #include "../include/renderer.hpp"
 #include "../include/score.hpp"
@@ -27,6 +27,9 @@ constexpr std::array<float, 9> COLLECT_PITCHES{
 };
 // clang-format on
 
+// Number of replay inputs between replay game keyframes.
+constexpr usize KEYFRAME_INTERVAL{10_s};
+
 // Center of the playing field.
 constexpr float FIELD_CENTER{FIELD_MIN + (FIELD_MAX - FIELD_MIN) / 2};
 // Size of the central scoring region.
@@ -50,18 +53,6 @@ constexpr glm::vec2 TIMER_TEXT_POS{500, 50};
 // Position of the score text.
 constexpr glm::vec2 SCORE_TEXT_POS{990, -4};
 
-//////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
-
-// Creates the number atlas used for the timer and score text.
-static tr::gfx::bitmap_atlas<char> create_number_atlas(text_engine& text_engine)
-{
-	std::unordered_map<char, tr::bitmap> glyphs;
-	for (char chr : std::string_view{"0123456789:-"}) {
-		glyphs.emplace(chr, text_engine.render_gradient_glyph(chr, font::DEFAULT, tr::sys::ttf_style::NORMAL, 64, 5));
-	}
-	return tr::gfx::build_bitmap_atlas(glyphs);
-}
-
 ///////////////////////////////////////////////////////////// PLAYERLESS GAME /////////////////////////////////////////////////////////////
 
 playerless_game::playerless_game(::gamemode gamemode, u64 rng_seed)
@@ -84,42 +75,85 @@ const gamemode& playerless_game::gamemode() const
 	return m_gamemode;
 }
 
+usize playerless_game::ball_count() const
+{
+	return m_balls.size();
+}
+
 //
 
 void playerless_game::add_new_ball()
 {
 	m_time_since_last_ball = 0;
-	m_balls.emplace_back(m_rng, m_next_ball_size, m_next_ball_velocity);
+	m_balls.emplace(m_rng, m_next_ball_size, m_next_ball_velocity);
 	m_next_ball_size = std::min(m_next_ball_size + m_gamemode.ball.size_step, 100.0f);
 	m_next_ball_velocity = std::min(m_next_ball_velocity + m_gamemode.ball.velocity_step, 5000.0f);
 }
 
-void playerless_game::tick()
+void playerless_game::tick(game_event_sink& events)
 {
 	++m_elapsed_time;
 
 	if (++m_time_since_last_ball >= m_gamemode.ball.spawn_interval && m_balls.size() < m_gamemode.ball.max_count) {
 		add_new_ball();
-		audio::instance().play_sound(sound::BALL_SPAWN, 0.25f, (m_balls.back().hitbox().c.x - 500) / 500);
+		events.play_sound(sound::BALL_SPAWN, 0.25f, (m_balls.hitbox(m_balls.size() - 1).c.x - 500) / 500);
 	}
 
-	for (auto ball_it = m_balls.begin(); ball_it != m_balls.end(); ++ball_it) {
-		ball_it->tick();
-		if (ball_it->tangible()) {
-			for (auto ball_jt = std::next(ball_it); ball_jt != m_balls.end(); ++ball_jt) {
-				if (ball_jt->tangible() && colliding(*ball_it, *ball_jt)) {
-					handle_collision(*ball_it, *ball_jt);
-				}
-			}
-		}
-	}
+	m_balls.tick(events);
+}
+
+//
+
+playerless_game_snapshot playerless_game::snapshot() const
+{
+	return {m_rng, m_balls, m_elapsed_time, m_time_since_last_ball, m_next_ball_size, m_next_ball_velocity};
+}
+
+void playerless_game::restore(const playerless_game_snapshot& snapshot)
+{
+	m_rng = snapshot.rng;
+	m_balls = snapshot.balls;
+	m_elapsed_time = snapshot.elapsed_time;
+	m_time_since_last_ball = snapshot.time_since_last_ball;
+	m_next_ball_size = snapshot.next_ball_size;
+	m_next_ball_velocity = snapshot.next_ball_velocity;
+}
+
+void playerless_game::copy_state(const playerless_game& source)
+{
+	m_rng = source.m_rng;
+	m_balls = source.m_balls;
+	m_elapsed_time = source.m_elapsed_time;
+	m_time_since_last_ball = source.m_time_since_last_ball;
+	m_next_ball_size = source.m_next_ball_size;
+	m_next_ball_velocity = source.m_next_ball_velocity;
+}
+
+u64 playerless_game::state_hash() const
+{
+	state_hasher hasher;
+	add_to_hash(hasher);
+	return hasher.value();
+}
+
+void playerless_game::add_to_hash(state_hasher& hasher) const
+{
+	// The generator's state isn't exposed, so a copy is advanced instead (diverging states yield different outputs).
+	tr::xorshiftr_128p rng{m_rng};
+	hasher.add(rng.generate<u64>());
+	hasher.add(rng.generate<u64>());
+	m_balls.add_to_hash(hasher);
+	hasher.add(m_elapsed_time);
+	hasher.add(m_time_since_last_ball);
+	hasher.add(m_next_ball_size);
+	hasher.add(m_next_ball_velocity);
 }
 
 //
 
 void playerless_game::add_ball_trail_overlay_to_renderer(tr::gfx::renderer_2d& renderer) const
 {
-	const tr::gfx::simple_color_mesh_ref overlay{renderer.new_color_fan(layer::BALL_TRAILS, 4, TRANSFORM, tr::gfx::REVERSE_ALPHA_BLENDING)};
+	const tr::gfx::simple_color_mesh_ref overlay{renderer.new_color_fan(layer::BALL_TRAILS_OVERLAY, 4, TRANSFORM, tr::gfx::REVERSE_ALPHA_BLENDING)};
 	std::ranges::copy(OVERLAY_POSITIONS, overlay.positions.begin());
 	std::ranges::fill(overlay.colors, "00000000"_rgba8);
 }
@@ -131,11 +165,9 @@ void playerless_game::add_border_to_renderer(tr::gfx::renderer_2d& renderer, flo
 	std::ranges::fill(border.colors, color_cast<tr::rgba8>(tr::hsv{hue, 1, 1}));
 }
 
-void playerless_game::add_to_renderer(renderer& renderer, float secondary_hue) const
+void playerless_game::add_to_renderer(renderer& renderer, float secondary_hue, float alpha) const
 {
-	for (const ball& ball : m_balls) {
-		ball.add_to_renderer(renderer, secondary_hue);
-	}
+	m_balls.add_to_renderer(renderer, secondary_hue, alpha);
 	add_ball_trail_overlay_to_renderer(renderer.basic());
 	add_border_to_renderer(renderer.basic(), secondary_hue);
 }
@@ -174,7 +206,6 @@ tr::rgba8 different_player_result_color_picker::score_color(i64) const
 
 game::game(results_color_picker results_color_picker, ::gamemode gamemode, u64 rng_seed)
 	: playerless_game{std::move(gamemode), rng_seed}
-	, m_number_atlas{create_number_atlas(renderer::instance().text_engine)}
 	, m_result_color_picker{results_color_picker}
 	, m_player{m_gamemode.player}
 	, m_lives_left{int(m_gamemode.player.starting_lives)}
@@ -207,29 +238,134 @@ ticks game::final_time() const
 
 //
 
-void game::tick(const glm::vec2& input)
+game_snapshot game::snapshot() const
+{
+	return {
+		.base = playerless_game::snapshot(),
+		.player = m_player.snapshot(),
+		.life_fragments = m_life_fragments,
+		.shattered_life_fragments = m_shattered_life_fragments,
+		.lives_left = m_lives_left,
+		.score = m_score,
+		.game_over_timer = m_game_over_timer,
+		.one_up_animation_timer = m_1up_animation_timer,
+		.hit_animation_timer = m_hit_animation_timer,
+		.screen_shake_timer = m_screen_shake_timer,
+		.style_cooldown_timer = m_style_cooldown_timer,
+		.score_animation_timer = m_score_animation_timer,
+		.center_timer = m_center_timer,
+		.edge_timer = m_edge_timer,
+		.corner_timer = m_corner_timer,
+		.lives_hover_timer = m_lives_hover_timer,
+		.timer_hover_timer = m_timer_hover_timer,
+		.score_hover_timer = m_score_hover_timer,
+		.tock = m_tock,
+	};
+}
+
+void game::restore(const game_snapshot& snapshot)
+{
+	playerless_game::restore(snapshot.base);
+	m_player.restore(snapshot.player);
+	m_life_fragments = snapshot.life_fragments;
+	m_shattered_life_fragments = snapshot.shattered_life_fragments;
+	m_lives_left = snapshot.lives_left;
+	m_score = snapshot.score;
+	m_game_over_timer = snapshot.game_over_timer;
+	m_1up_animation_timer = snapshot.one_up_animation_timer;
+	m_hit_animation_timer = snapshot.hit_animation_timer;
+	m_screen_shake_timer = snapshot.screen_shake_timer;
+	m_style_cooldown_timer = snapshot.style_cooldown_timer;
+	m_score_animation_timer = snapshot.score_animation_timer;
+	m_center_timer = snapshot.center_timer;
+	m_edge_timer = snapshot.edge_timer;
+	m_corner_timer = snapshot.corner_timer;
+	m_lives_hover_timer = snapshot.lives_hover_timer;
+	m_timer_hover_timer = snapshot.timer_hover_timer;
+	m_score_hover_timer = snapshot.score_hover_timer;
+	m_tock = snapshot.tock;
+}
+
+void game::copy_state(const game& source)
+{
+	playerless_game::copy_state(source);
+	m_player.copy_state(source.m_player);
+	m_life_fragments = source.m_life_fragments;
+	m_shattered_life_fragments = source.m_shattered_life_fragments;
+	m_lives_left = source.m_lives_left;
+	m_score = source.m_score;
+	m_game_over_timer = source.m_game_over_timer;
+	m_1up_animation_timer = source.m_1up_animation_timer;
+	m_hit_animation_timer = source.m_hit_animation_timer;
+	m_screen_shake_timer = source.m_screen_shake_timer;
+	m_style_cooldown_timer = source.m_style_cooldown_timer;
+	m_score_animation_timer = source.m_score_animation_timer;
+	m_center_timer = source.m_center_timer;
+	m_edge_timer = source.m_edge_timer;
+	m_corner_timer = source.m_corner_timer;
+	m_lives_hover_timer = source.m_lives_hover_timer;
+	m_timer_hover_timer = source.m_timer_hover_timer;
+	m_score_hover_timer = source.m_score_hover_timer;
+	m_tock = source.m_tock;
+}
+
+u64 game::state_hash() const
+{
+	state_hasher hasher;
+	playerless_game::add_to_hash(hasher);
+	const tr::circle hitbox{m_player.hitbox()};
+	hasher.add(hitbox.c.x);
+	hasher.add(hitbox.c.y);
+	hasher.add(hitbox.r);
+	hasher.add(m_lives_left);
+	hasher.add(m_score);
+	return hasher.value();
+}
+
+//
+
+void game::tick(const glm::vec2& input, game_event_sink& events)
 {
-	play_tick_sound_if_needed();
-	playerless_game::tick();
+	play_tick_sound_if_needed(events);
+	playerless_game::tick(events);
 	update_timers();
-	update_life_fragments();
+	update_life_fragments(events);
 	if (!game_over()) {
 		m_player.tick(input);
-		check_if_timer_obstructed(renderer::instance().scale());
+		check_if_timer_obstructed();
 		check_if_lives_obstructed();
-		check_if_score_obstructed(renderer::instance().scale());
-		check_if_player_was_hit();
-		check_if_player_collected_life_fragments();
+		check_if_score_obstructed();
+		check_if_player_was_hit(events);
+		check_if_player_collected_life_fragments(events);
 		check_for_score_ticks();
-		check_for_style_points();
+		check_for_style_points(events);
 	}
 	else {
 		m_player.update_fragments();
 	}
-	set_screen_shake(renderer::instance());
+	set_screen_shake(events);
+}
+
+//
+
+const ball_list& game::balls() const
+{
+	return m_balls;
+}
+
+const tr::circle& game::player_hitbox() const
+{
+	return m_player.hitbox();
 }
 
-void game::play_tick_sound_if_needed()
+const results_color_picker& game::result_color_picker() const
+{
+	return m_result_color_picker;
+}
+
+//
+
+void game::play_tick_sound_if_needed(game_event_sink& events)
 {
 	if (game_over()) {
 		return;
@@ -237,7 +373,7 @@ void game::play_tick_sound_if_needed()
 
 	if (std::ranges::none_of(m_life_fragments, &life_fragment::collectible)) {
 		if (m_elapsed_time % 1_s == 0) {
-			audio::instance().play_sound(sound::TICK, 0.33f, 0.0f, m_tock ? 0.75f : 1.0f);
+			events.play_sound(sound::TICK, 0.33f, 0.0f, m_tock ? 0.75f : 1.0f);
 			m_tock = !m_tock;
 		}
 		return;
@@ -248,7 +384,7 @@ void game::play_tick_sound_if_needed()
 						 : life_fragment_timer >= LIFE_FRAGMENT_SLOW_FLASH_START ? 0.2_s
 																				 : 0.5_s};
 	if (life_fragment_timer % interval == 0) {
-		audio::instance().play_sound(sound::TICK_ALT, 0.75f, 0.0f, 1.0f);
+		events.play_sound(sound::TICK_ALT, 0.75f, 0.0f, 1.0f);
 	}
 }
 
@@ -264,7 +400,7 @@ void game::update_timers()
 	m_score_animation_timer.tick();
 }
 
-void game::update_life_fragments()
+void game::update_life_fragments(game_event_sink& events)
 {
 	if (!m_gamemode.player.spawn_life_fragments) {
 		return;
@@ -291,13 +427,14 @@ void game::update_life_fragments()
 			}
 		}
 
-		audio::instance().play_sound(sound::FRAGMENT_SPAWN, 1, 0);
+		events.play_sound(sound::FRAGMENT_SPAWN, 1, 0);
 	}
 }
 
-void game::check_if_timer_obstructed(float renderer_scale)
+void game::check_if_timer_obstructed()
 {
-	const glm::vec2 size{text_size(format_time(m_elapsed_time), renderer_scale, 1.0f) * 0.95f};
+	number_buffer buffer;
+	const glm::vec2 size{text_size(format_time(buffer, m_elapsed_time), 1.0f) * 0.95f};
 	const tr::frect2 base_bounds{TIMER_TEXT_POS - size / 2.0f - 8.0f, size + 16.0f};
 
 	const tr::circle player_hitbox{m_player.hitbox()};
@@ -343,9 +480,10 @@ void game::check_if_lives_obstructed()
 	m_lives_hover_timer.decrement();
 }
 
-void game::check_if_score_obstructed(float renderer_scale)
+void game::check_if_score_obstructed()
 {
-	const glm::vec2 size{text_size(format_score(m_score), renderer_scale, 1.0f) * 0.75f};
+	number_buffer buffer;
+	const glm::vec2 size{text_size(format_score(buffer, m_score), 1.0f) * 0.75f};
 	const tr::frect2 base_bounds{tl(SCORE_TEXT_POS, size, tr::align::TOP_RIGHT), size};
 
 	const tr::circle player_hitbox{m_player.hitbox()};
@@ -366,23 +504,23 @@ void game::check_if_score_obstructed(float renderer_scale)
 	m_score_hover_timer.decrement();
 }
 
-void game::check_if_player_was_hit()
+void game::check_if_player_was_hit(game_event_sink& events)
 {
-	const auto hit_player{[&](const ball& b) { return b.tangible() && tr::intersecting(b.hitbox(), m_player.hitbox()); }};
-	if (!m_player.invincible() && std::ranges::any_of(m_balls, hit_player)) {
+	const auto hit_player{[&](usize i) { return m_balls.tangible(i) && tr::intersecting(m_balls.hitbox(i), m_player.hitbox()); }};
+	if (!m_player.invincible() && std::ranges::any_of(std::views::iota(0_uz, m_balls.size()), hit_player)) {
 		--m_lives_left;
 		if (m_lives_left < 0) {
 			m_game_over_timer.start();
 			m_screen_shake_timer.start();
 			m_player.kill();
-			audio::instance().play_sound(sound::GAME_OVER, 1, 0);
+			events.play_sound(sound::GAME_OVER, 1, 0);
 		}
 		else {
 			m_hit_animation_timer.start();
 			m_screen_shake_timer.start();
 			m_player.hit();
 			set_up_shattered_life_fragments();
-			audio::instance().play_sound(sound::HIT, 1, 0);
+			events.play_sound(sound::HIT, 1, 0);
 		}
 	}
 }
@@ -401,7 +539,7 @@ void game::set_up_shattered_life_fragments()
 	}
 }
 
-void game::check_if_player_collected_life_fragments()
+void game::check_if_player_collected_life_fragments(game_event_sink& events)
 {
 	for (life_fragment& fragment : m_life_fragments) {
 		if (fragment.collectible() && tr::intersecting(fragment.hitbox(), m_player.hitbox())) {
@@ -414,9 +552,9 @@ void game::check_if_player_collected_life_fragments()
 				++m_lives_left;
 				m_1up_animation_timer.start();
 				add_to_score(150);
-				audio::instance().play_sound(sound::ONE_UP, 1.25f, 0);
+				events.play_sound(sound::ONE_UP, 1.25f, 0);
 			}
-			audio::instance().play_sound(sound::COLLECT, 0.65f, 0, COLLECT_PITCHES[collected_fragments - 1]);
+			events.play_sound(sound::COLLECT, 0.65f, 0, COLLECT_PITCHES[collected_fragments - 1]);
 		}
 	}
 }
@@ -476,25 +614,30 @@ void game::check_for_score_ticks()
 	}
 }
 
-bool game::player_in_ball_style_region(const ball& ball, float ball_velocity) const
+bool game::player_in_ball_style_region(const tr::circle& ball_hitbox, glm::vec2 ball_velocity) const
 {
-	const tr::angle rect_angle{tr::atan2(ball.velocity().y / ball_velocity, ball.velocity().x / ball_velocity)};
-	const glm::vec2 rect_size{ball.hitbox().r + ball_velocity / 3, ball.hitbox().r * 2 + 2 * m_player.hitbox().r};
-	const glm::vec2 rect_center{ball.hitbox().c + ball.velocity() / 6.0f + tr::magth(ball.hitbox().r, rect_angle)};
+	const float ball_speed{glm::length(ball_velocity)};
+	const tr::angle rect_angle{sim_atan2(ball_velocity.y / ball_speed, ball_velocity.x / ball_speed)};
+	const glm::vec2 rect_size{ball_hitbox.r + ball_speed / 3, ball_hitbox.r * 2 + 2 * m_player.hitbox().r};
+	const glm::vec2 rect_center{ball_hitbox.c + ball_velocity / 6.0f + sim_magth(ball_hitbox.r, rect_angle)};
 	const tr::frect2 unrotated_rect{tr::frect2{rect_center - rect_size / 2.0f, rect_size}};
-	const glm::mat4 inverse_rotation{tr::rotate_around(1.0f, rect_center, -rect_angle)};
-	return unrotated_rect.contains(inverse_rotation * m_player.hitbox().c);
+	return unrotated_rect.contains(sim_rotate_around(m_player.hitbox().c, rect_center, -rect_angle));
 }
 
-void game::check_for_style_points()
+void game::check_for_style_points(game_event_sink& events)
 {
 	m_style_cooldown_timer.tick();
 	if (!m_style_cooldown_timer.active()) {
 		i64 max_points{0};
-		for (const ball& ball : std::views::filter(m_balls, &ball::tangible)) {
-			const float ball_velocity{glm::length(ball.velocity())};
-			if (player_in_ball_style_region(ball, ball_velocity)) {
-				const i64 points{tr::floor_cast<i64>(std::sqrt(ball.hitbox().r / 10) * std::pow(ball_velocity / 250, 1.5f))};
+		for (usize i = 0; i < m_balls.size(); ++i) {
+			if (!m_balls.tangible(i)) {
+				continue;
+			}
+
+			const tr::circle ball_hitbox{m_balls.hitbox(i)};
+			const glm::vec2 ball_velocity{m_balls.velocity(i)};
+			if (player_in_ball_style_region(ball_hitbox, ball_velocity)) {
+				const i64 points{tr::floor_cast<i64>(std::sqrt(ball_hitbox.r / 10) * sim_pow_1_5(glm::length(ball_velocity) / 250))};
 				max_points = std::max({1_i64, points, max_points});
 			}
 		}
@@ -502,31 +645,23 @@ void game::check_for_style_points()
 			const float pan{(m_player.hitbox().c.x - 500) / 500};
 			add_to_score(max_points);
 			m_style_cooldown_timer.start();
-			audio::instance().play_sound(sound::STYLE, 0.25f, pan);
+			events.play_sound(sound::STYLE, 0.25f, pan);
 		}
 	}
 }
 
-void game::set_screen_shake(renderer& renderer) const
+void game::set_screen_shake(game_event_sink& events) const
 {
 	if (m_screen_shake_timer.active()) {
-		const glm::vec2 tl{tr::magth(40 * (1 - m_screen_shake_timer.elapsed_ratio()), g_rng.generate_angle())};
-		renderer.set_default_transform(tr::ortho(tr::frect2{tl, glm::vec2{1000}}));
+		events.shake_screen(tr::magth(40 * (1 - m_screen_shake_timer.elapsed_ratio()), g_rng.generate_angle()));
 	}
 }
 
 //
 
-glm::vec2 game::text_size(const std::string& text, float renderer_scale, float scale) const
+glm::vec2 game::text_size(std::string_view text, float scale) const
 {
-	const tr::gfx::dyn_atlas<char>& atlas{tr::get<tr::gfx::dyn_atlas<char>>(m_number_atlas)};
-
-	glm::vec2 text_size{};
-	for (char chr : text) {
-		const glm::vec2 char_size{glm::vec2{atlas.unnormalized(chr).size} / renderer_scale * scale};
-		text_size = {text_size.x + char_size.x - 5, std::max<float>(text_size.y, char_size.y)};
-	}
-	return text_size;
+	return number_text_size(m_number_sizes, text, scale);
 }
 
 struct game::timer_render_info game::timer_render_info() const
@@ -569,20 +704,11 @@ struct game::score_render_info game::score_render_info() const
 
 void game::add_timer_to_renderer(renderer& renderer) const
 {
-	const tr::gfx::dyn_atlas<char>& atlas{tr::get<tr::gfx::dyn_atlas<char>>(m_number_atlas)};
 	const auto [time, tint, scale]{timer_render_info()};
-	const std::string text{format_time(time)};
-
-	glm::vec2 tl{TIMER_TEXT_POS - text_size(text, renderer.scale(), scale) / 2.0f};
-	for (char chr : text) {
-		const glm::vec2 size{glm::vec2{atlas.unnormalized(chr).size} / renderer.scale() * scale};
-
-		const tr::gfx::simple_textured_mesh_ref character{renderer.basic().new_textured_fan(layer::GAME_OVERLAY, 4)};
-		tr::fill_rectangle_vertices(character.positions, {tl, size});
-		tr::fill_rectangle_vertices(character.uvs, atlas[chr]);
-		std::ranges::fill(character.tints, tint);
-		tl.x += size.x - 5;
-	}
+	number_buffer buffer;
+	const std::string_view text{format_time(buffer, time)};
+	const glm::vec2 tl{TIMER_TEXT_POS - text_size(text, scale) / 2.0f};
+	renderer.numbers().add_to_renderer(renderer.basic(), layer::GAME_OVERLAY, text, tl, scale, tint);
 }
 
 void game::add_lives_to_renderer(tr::gfx::renderer_2d& renderer, float hue) const
@@ -644,42 +770,27 @@ void game::add_shattering_life_to_renderer(tr::gfx::renderer_2d& renderer, tr::r
 
 void game::add_score_to_renderer(renderer& renderer) const
 {
-	const tr::gfx::dyn_atlas<char>& atlas{tr::get<tr::gfx::dyn_atlas<char>>(m_number_atlas)};
 	const auto [tint, scale]{score_render_info()};
-	const std::string text{format_score(m_score)};
-
-	glm::vec2 tl{tr::tl(SCORE_TEXT_POS, text_size(text, renderer.scale(), scale), tr::align::TOP_RIGHT)};
-	for (char chr : text) {
-		const glm::vec2 size{glm::vec2{atlas.unnormalized(chr).size} / renderer.scale() * scale};
-
-		const tr::gfx::simple_textured_mesh_ref character{renderer.basic().new_textured_fan(layer::GAME_OVERLAY, 4)};
-		tr::fill_rectangle_vertices(character.positions, {tl, size});
-		tr::fill_rectangle_vertices(character.uvs, atlas[chr]);
-		std::ranges::fill(character.tints, tint);
-		tl.x += size.x - 5;
-	}
+	number_buffer buffer;
+	const std::string_view text{format_score(buffer, m_score)};
+	const glm::vec2 tl{tr::tl(SCORE_TEXT_POS, text_size(text, scale), tr::align::TOP_RIGHT)};
+	renderer.numbers().add_to_renderer(renderer.basic(), layer::GAME_OVERLAY, text, tl, scale, tint);
 }
 
-void game::add_to_renderer(renderer& renderer, float primary_hue, float secondary_hue) const
+void game::add_to_renderer(renderer& renderer, float primary_hue, float secondary_hue, float alpha) const
 {
-	tr::gfx::bitmap_atlas<char>* const number_atlas_bitmap{std::get_if<tr::gfx::bitmap_atlas<char>>(&m_number_atlas)};
-	if (number_atlas_bitmap != nullptr) {
-		tr::gfx::bitmap_atlas<char> source{std::move(*number_atlas_bitmap)};
-		tr::gfx::dyn_atlas<char>& atlas{m_number_atlas.emplace<tr::gfx::dyn_atlas<char>>(std::move(source))};
-		atlas.set_filtering(tr::gfx::min_filter::LINEAR, tr::gfx::mag_filter::LINEAR);
-		renderer.basic().set_default_layer_texture(layer::GAME_OVERLAY, atlas);
-	}
+	m_number_sizes = renderer.numbers().sizes();
 
-	playerless_game::add_to_renderer(renderer, secondary_hue);
+	playerless_game::add_to_renderer(renderer, secondary_hue, alpha);
 	for (const life_fragment& fragment : m_life_fragments) {
 		fragment.add_to_renderer(renderer);
 	}
 	add_timer_to_renderer(renderer);
 	if (game_over()) {
-		m_player.add_to_renderer_dead(renderer, m_game_over_timer.elapsed());
+		m_player.add_to_renderer_dead(renderer, primary_hue, m_game_over_timer.elapsed());
 	}
 	else {
-		m_player.add_to_renderer_alive(renderer, m_elapsed_time, m_style_cooldown_timer);
+		m_player.add_to_renderer_alive(renderer, primary_hue, m_elapsed_time, m_style_cooldown_timer, alpha);
 		add_lives_to_renderer(renderer.basic(), primary_hue);
 	}
 	add_score_to_renderer(renderer);
@@ -687,31 +798,40 @@ void game::add_to_renderer(renderer& renderer, float primary_hue, float secondar
 
 /////////////////////////////////////////////////////////////// ACTIVE GAME ///////////////////////////////////////////////////////////////
 
-active_game::active_game(const input& input, savefile savefile, ::gamemode gamemode, u64 seed)
-	: game{same_player_result_color_picker{savefile.best_results(gamemode)}, std::move(gamemode), seed}
-	, replay{savefile.name(), this->gamemode(), seed}
+active_game::active_game(const input& input, savefile_snapshot savefile, ::gamemode gamemode, u64 seed,
+						 const std::filesystem::path& replay_directory)
+	: game{same_player_result_color_picker{savefile->best_results(gamemode)}, std::move(gamemode), seed}
+	, replay{savefile->name(), this->gamemode(), seed, replay_directory}
 	, m_input{input}
 {
 }
 
 //
 
-void active_game::tick()
+void active_game::tick(game_event_sink& events)
 {
+	tick(m_input.mouse_pos, events);
+}
+
+void active_game::tick(glm::vec2 mouse_pos, game_event_sink& events)
+{
+	// The game has to be fed the quantized input so that it is exactly reproduced when the replay is played back.
 	const bool was_game_over{game_over()};
-	game::tick(m_input.mouse_pos);
+	const glm::vec2 input{quantize_replay_input(mouse_pos)};
+	game::tick(input, events);
 	if (!was_game_over) {
-		replay.append(m_input.mouse_pos);
+		replay.append(input);
+		if (replay.position() % STATE_HASH_INTERVAL == 0) {
+			replay.append_state_hash(state_hash());
+		}
 	}
 }
 
 ////////////////////////////////////////////////////////////// REPLAY GAME ////////////////////////////////////////////////////////////////
 
 // Creates an appropriate results color picker for a replay.
-static results_color_picker replay_results_color_picker(const replay& replay)
+static results_color_picker replay_results_color_picker(const replay& replay, const savefile& savefile)
 {
-	savefile savefile;
-
 	if (replay.header().player != savefile.name()) {
 		return same_player_result_color_picker{savefile.best_results(replay.header().gamemode)};
 	}
@@ -720,16 +840,22 @@ static results_color_picker replay_results_color_picker(const replay& replay)
 	}
 }
 
-replay_game::replay_game(replay&& replay)
-	: game{replay_results_color_picker(replay), replay.header().gamemode, replay.header().seed}, m_replay{std::move(replay)}
+replay_game::replay_game(replay&& replay, savefile_snapshot savefile)
+	: replay_game{std::move(replay), replay_results_color_picker(replay, *savefile)}
 {
 }
 
 replay_game::replay_game(const replay_game& r)
-	: replay_game{replay{r.m_replay}}
+	: replay_game{replay{r.m_replay}, r.result_color_picker()}
 {
 }
 
+replay_game::replay_game(replay&& replay, results_color_picker results_color_picker)
+	: game{std::move(results_color_picker), replay.header().gamemode, replay.header().seed}, m_replay{std::move(replay)}
+{
+	m_keyframes.push_back(snapshot());
+}
+
 //
 
 bool replay_game::done() const
@@ -742,9 +868,98 @@ glm::vec2 replay_game::cursor_pos() const
 	return m_replay.prev_input();
 }
 
+usize replay_game::position() const
+{
+	return m_replay.position();
+}
+
+//
+
+std::optional<usize> replay_game::first_desync() const
+{
+	return m_first_desync;
+}
+
+//
+
+void replay_game::tick(game_event_sink& events)
+{
+	const bool reading_inputs{!done()};
+	game::tick(reading_inputs ? m_replay.next_input() : m_replay.prev_input(), events);
+	if (reading_inputs) {
+		check_state_hash();
+	}
+	if (m_replay.position() == m_keyframes.size() * KEYFRAME_INTERVAL) {
+		m_keyframes.push_back(snapshot());
+	}
+}
+
+void replay_game::seek(usize position)
+{
+	// Going back or past a later keyframe restores the closest keyframe before the target, the rest is simulated silently.
+	const usize keyframe{std::min(position / KEYFRAME_INTERVAL, m_keyframes.size() - 1)};
+	if (position < m_replay.position() || keyframe * KEYFRAME_INTERVAL > m_replay.position()) {
+		restore(m_keyframes[keyframe]);
+		m_replay.seek(keyframe * KEYFRAME_INTERVAL);
+	}
+
+	null_event_sink events;
+	while (m_replay.position() < position && !done()) {
+		tick(events);
+	}
+}
+
+//
+
+void replay_game::check_state_hash()
+{
+	const usize position{m_replay.position()};
+	const std::optional<u64> recorded_hash{m_replay.state_hash(position)};
+	if (recorded_hash.has_value() && *recorded_hash != state_hash() && (!m_first_desync.has_value() || position < *m_first_desync)) {
+		m_first_desync = position;
+	}
+}
+
+//////////////////////////////////////////////////////////////// BOT GAME /////////////////////////////////////////////////////////////////
+
+bot_game::bot_game(::gamemode gamemode, u64 seed, const bot_settings& settings)
+	: game{different_player_result_color_picker{}, std::move(gamemode), seed}, m_bot{settings}
+{
+}
+
+bot_game::bot_game(::gamemode gamemode, u64 seed, const bot_settings& settings, const std::filesystem::path& replay_directory)
+	: game{different_player_result_color_picker{}, std::move(gamemode), seed}
+	, replay{std::in_place, "Bot", this->gamemode(), seed, replay_directory}
+	, m_bot{settings}
+{
+}
+
+//
+
+void bot_game::tick(game_event_sink& events)
+{
+	// The bot's input is quantized the same way as in active games, so recorded replays are played back exactly.
+	const bool was_game_over{game_over()};
+	const glm::vec2 input{quantize_replay_input(m_bot.steer(player_hitbox(), gamemode().player.inertia_factor, balls()))};
+	game::tick(input, events);
+	if (replay.has_value() && !was_game_over) {
+		replay->append(input);
+		if (replay->position() % STATE_HASH_INTERVAL == 0) {
+			replay->append_state_hash(state_hash());
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////// SNAPSHOT GAME //////////////////////////////////////////////////////////////
+
+snapshot_game::snapshot_game(const game& source)
+	: game{source.m_result_color_picker, source.gamemode(), 0}
+{
+	copy_state(source);
+}
+
 //
 
-void replay_game::tick()
+void snapshot_game::tick(game_event_sink&)
 {
-	game::tick(done() ? m_replay.prev_input() : m_replay.next_input());
 }
\ No newline at end of file
@@ -5,8 +5,10 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "../../include/game/ball.hpp"
-#include "../../include/audio.hpp"
+#include "../../include/game/collision_grid.hpp"
+#include "../../include/game/sim_math.hpp"
 #include "../../include/renderer.hpp"
+#include <bitset>
 
 //////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
 
@@ -18,167 +20,235 @@ constexpr ticks BALL_COLLISION_ANIMATION_TIME{0.1_s};
 //////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
 
 // Plays a sound emitted by a ball.
-static void play_ball_sound(glm::vec2 pos, float velocity)
+static void play_ball_sound(game_event_sink& events, glm::vec2 pos, float velocity)
 {
 	const float pan{(pos.x - 500) / 500};
 	const float pitch{std::clamp(velocity / 600, 0.75f, 1.25f)};
-	audio::instance().play_sound(sound::BOUNCE, 0.15f, pan, g_rng.generate(pitch - 0.2f, pitch + 0.2f));
+	events.play_sound(sound::BOUNCE, 0.15f, pan, g_rng.generate(pitch - 0.2f, pitch + 0.2f));
 }
 
-////////////////////////////////////////////////////////////////// BALL ///////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////// BALLS //////////////////////////////////////////////////////////////////
 
-ball::ball(const tr::circle& hitbox, const glm::vec2& velocity)
-	: m_hitbox{hitbox}, m_trail{hitbox.c}, m_velocity{velocity}, m_age{0}, m_time_since_last_collision{0}
+usize ball_list::size() const
 {
+	return m_size;
 }
 
-ball::ball(tr::xorshiftr_128p& rng, float size, float velocity)
-	: ball{{{rng.generate(FIELD_MIN + size, FIELD_MAX - size), rng.generate(FIELD_MIN + size, FIELD_MAX - size)}, size},
-		   rng.generate_vector(velocity)}
+bool ball_list::tangible(usize i) const
 {
+	return m_ages[i] >= BALL_SPAWN_ANIMATION_TIME;
 }
 
-//
+tr::circle ball_list::hitbox(usize i) const
+{
+	return {{m_xs[i], m_ys[i]}, m_radii[i]};
+}
 
-bool ball::tangible() const
+glm::vec2 ball_list::velocity(usize i) const
 {
-	return m_age >= BALL_SPAWN_ANIMATION_TIME;
+	return {m_vxs[i], m_vys[i]};
 }
 
-const tr::circle& ball::hitbox() const
+//
+
+void ball_list::emplace(const tr::circle& hitbox, glm::vec2 velocity)
 {
-	return m_hitbox;
+	m_xs[m_size] = hitbox.c.x;
+	m_ys[m_size] = hitbox.c.y;
+	m_vxs[m_size] = velocity.x;
+	m_vys[m_size] = velocity.y;
+	m_radii[m_size] = hitbox.r;
+	m_ages[m_size] = 0;
+	m_times_since_last_collision[m_size] = 0;
+	m_trails.emplace_back(hitbox.c);
+	++m_size;
 }
 
-const glm::vec2& ball::velocity() const
+void ball_list::emplace(tr::xorshiftr_128p& rng, float size, float velocity)
 {
-	return m_velocity;
+	const glm::vec2 pos{rng.generate(FIELD_MIN + size, FIELD_MAX - size), rng.generate(FIELD_MIN + size, FIELD_MAX - size)};
+	emplace({pos, size}, sim_random_vector(rng, velocity));
 }
 
 //
 
-void ball::tick()
+void ball_list::tick(game_event_sink& events)
 {
-	++m_age;
-	++m_time_since_last_collision;
-
-	if (tangible()) {
-		m_trail.push(m_hitbox.c);
-
-		const glm::vec2 target{m_hitbox.c + m_velocity / 1_sf};
-		const glm::vec2 clamped{tr::mirror_repeat(target, glm::vec2{FIELD_MIN + m_hitbox.r}, glm::vec2{FIELD_MAX - m_hitbox.r})};
-
-		if (std::abs(clamped.x - target.x) < 1e-3f && std::abs(clamped.y - target.y) < 1e-3f) {
-			m_hitbox.c = target;
-			return;
+	integration integration;
+	integrate(integration);
+
+	// Balls are checked against every later ball right after being updated, before the later balls are. The grid preserves this order.
+	std::bitset<MAX_BALLS> velocity_changed;
+	collision_grid grid{*this};
+	for (usize i = 0; i < m_size; ++i) {
+		++m_ages[i];
+		++m_times_since_last_collision[i];
+		if (!tangible(i)) {
+			continue;
 		}
 
-		if (clamped.x > target.x) {
-			m_velocity.x = std::abs(m_velocity.x);
+		m_trails[i].push({m_xs[i], m_ys[i]});
+		if (integration.in_bounds[i] && !velocity_changed[i]) {
+			m_xs[i] = integration.xs[i];
+			m_ys[i] = integration.ys[i];
 		}
-		else if (clamped.x < target.x) {
-			m_velocity.x = -std::abs(m_velocity.x);
+		else {
+			move_and_reflect(i, events);
 		}
 
-		if (clamped.y > target.y) {
-			m_velocity.y = std::abs(m_velocity.y);
-		}
-		else if (clamped.y < target.y) {
-			m_velocity.y = -std::abs(m_velocity.y);
+		grid.update(u8(i), {m_xs[i], m_ys[i]});
+		for (u8 j : grid.candidates_after(u8(i))) {
+			if (tangible(j) && colliding(i, j)) {
+				handle_collision(i, j, events);
+				velocity_changed.set(j);
+			}
 		}
+	}
+}
 
-		if (clamped != target) {
-			play_ball_sound(clamped, glm::length(m_velocity));
-		}
+void ball_list::integrate(integration& out) const
+{
+	// Must perform exactly the same operations as move_and_reflect for the results to be bit-identical.
+	for (usize i = 0; i < m_size; ++i) {
+		const float min{FIELD_MIN + m_radii[i]};
+		const float max{FIELD_MAX - m_radii[i]};
+		out.xs[i] = m_xs[i] + m_vxs[i] / 1_sf;
+		out.ys[i] = m_ys[i] + m_vys[i] / 1_sf;
+		out.in_bounds[i] = (out.xs[i] > min) & (out.xs[i] < max) & (out.ys[i] > min) & (out.ys[i] < max);
+	}
+}
+
+void ball_list::move_and_reflect(usize i, game_event_sink& events)
+{
+	const float r{m_radii[i]};
+	const glm::vec2 target{glm::vec2{m_xs[i], m_ys[i]} + glm::vec2{m_vxs[i], m_vys[i]} / 1_sf};
+	const glm::vec2 clamped{tr::mirror_repeat(target, glm::vec2{FIELD_MIN + r}, glm::vec2{FIELD_MAX - r})};
+
+	if (std::abs(clamped.x - target.x) < 1e-3f && std::abs(clamped.y - target.y) < 1e-3f) {
+		m_xs[i] = target.x;
+		m_ys[i] = target.y;
+		return;
+	}
+
+	if (clamped.x > target.x) {
+		m_vxs[i] = std::abs(m_vxs[i]);
+	}
+	else if (clamped.x < target.x) {
+		m_vxs[i] = -std::abs(m_vxs[i]);
+	}
 
-		m_hitbox.c = clamped;
-		m_time_since_last_collision = 0;
+	if (clamped.y > target.y) {
+		m_vys[i] = std::abs(m_vys[i]);
 	}
+	else if (clamped.y < target.y) {
+		m_vys[i] = -std::abs(m_vys[i]);
+	}
+
+	if (clamped != target) {
+		play_ball_sound(events, clamped, glm::length(velocity(i)));
+	}
+
+	m_xs[i] = clamped.x;
+	m_ys[i] = clamped.y;
+	m_times_since_last_collision[i] = 0;
 }
 
-//
+bool ball_list::colliding(usize a, usize b) const
+{
+	return tr::intersecting(hitbox(a), hitbox(b)) && glm::dot(hitbox(a).c - hitbox(b).c, velocity(b) - velocity(a)) >= 0;
+}
 
-void ball::add_to_renderer(renderer& renderer, float hue) const
+void ball_list::handle_collision(usize a, usize b, game_event_sink& events)
 {
-	const tr::rgb8 tint{tr::color_cast<tr::rgb8>(tr::hsv{hue, 1, 1})};
-	const float raw_age_factor{std::min(float(m_age) / BALL_SPAWN_ANIMATION_TIME, 1.0f)};
-	const float eased_age_factor{raw_age_factor == 1.0f ? raw_age_factor : 1.0f - std::pow(2.0f, -10.0f * raw_age_factor)};
-	const float size{m_hitbox.r * (5 - 4 * eased_age_factor)};
-	const usize vertices{tr::smooth_polygon_vertices(size * renderer.scale())};
-	const u8 base_opacity{tr::norm_cast<u8>(raw_age_factor)};
-	const float thickness{
-		3 + 4 * std::max((float(BALL_COLLISION_ANIMATION_TIME) - m_time_since_last_collision) / BALL_COLLISION_ANIMATION_TIME, 0.0f),
-	};
+	const glm::vec2 dist_vec{hitbox(a).c - hitbox(b).c};
+	const glm::vec2 vel_diff{velocity(a) - velocity(b)};
+	const float dist2{dist_vec.x * dist_vec.x + dist_vec.y * dist_vec.y};
+	const glm::vec2 impulse_vec{glm::dot(dist_vec, vel_diff) / dist2 * dist_vec};
+	const float a_mass{m_radii[a]};
+	const float b_mass{m_radii[b]};
+	const float total_mass{a_mass + b_mass};
 
-	renderer.circle().add_outlined_circle(layer::BALLS, {m_hitbox.c, size}, thickness, tr::rgba8{0, 0, 0, base_opacity},
-										  tr::rgba8{tint, base_opacity});
+	play_ball_sound(events, hitbox(b).c + dist_vec / 2.0f, std::max(glm::length(velocity(a)), glm::length(velocity(b))));
 
-	// Add the trail.
-	if (m_age > BALL_SPAWN_ANIMATION_TIME) {
-		usize drawn_trails{2};
-		for (usize i = 0; i < TRAIL_SIZE - 1; ++i) {
-			const glm::vec2 prev{i == 0 ? m_hitbox.c : m_trail[i - 1]};
-			if (!tr::collinear(prev, m_trail[i], m_trail[i + 1])) {
-				++drawn_trails;
-			}
-		}
-		const usize trail_vertices{drawn_trails * vertices};
-		const usize trail_indices{(drawn_trails - 1) * vertices * 6};
-
-		tr::gfx::color_mesh_ref trail{renderer.basic().new_color_mesh(layer::BALL_TRAILS, trail_vertices, trail_indices)};
-		tr::fill_circle_vertices(trail.positions.begin(), vertices, m_hitbox);
-		std::ranges::fill(trail.colors | std::views::take(vertices), tr::rgba8{tint, tr::norm_cast<u8>(0.4f)});
-		usize trail_index{1};
-		std::vector<u16>::iterator indices_it{trail.indices.begin()};
-		for (usize i = 0; i < TRAIL_SIZE; ++i) {
-			// Cull unnecessary trail vertices.
-			if (i < TRAIL_SIZE - 1) {
-				const glm::vec2 prev{i == 0 ? m_hitbox.c : m_trail[i - 1]};
-				if (tr::collinear(prev, m_trail[i], m_trail[i + 1])) {
-					continue;
-				}
-			}
+	const glm::vec2 a_velocity{velocity(a) - 2 * b_mass / total_mass * impulse_vec};
+	const glm::vec2 b_velocity{velocity(b) - 2 * a_mass / total_mass * -impulse_vec};
+	m_vxs[a] = a_velocity.x;
+	m_vys[a] = a_velocity.y;
+	m_vxs[b] = b_velocity.x;
+	m_vys[b] = b_velocity.y;
 
-			const u8 opacity{tr::norm_cast<u8>((TRAIL_SIZE - i - 1) * 0.4f / TRAIL_SIZE)};
-			const auto positions{trail.positions | std::views::drop(trail_index * vertices) | std::views::take(vertices)};
-			const auto colors{trail.colors | std::views::drop(trail_index * vertices) | std::views::take(vertices)};
-			tr::fill_circle_vertices(positions, {m_trail[i], m_hitbox.r});
-			std::ranges::fill(colors, tr::rgba8{tint, opacity});
-			for (usize j = 0; j < vertices; ++j) {
-				*indices_it++ = u16(trail.base_index + trail_index * vertices + j);
-				*indices_it++ = u16(trail.base_index + trail_index * vertices + (j + 1) % vertices);
-				*indices_it++ = u16(trail.base_index + (trail_index - 1) * vertices + (j + 1) % vertices);
-				*indices_it++ = u16(trail.base_index + trail_index * vertices + j);
-				*indices_it++ = u16(trail.base_index + (trail_index - 1) * vertices + (j + 1) % vertices);
-				*indices_it++ = u16(trail.base_index + (trail_index - 1) * vertices + j);
-			}
-			++trail_index;
-		}
+	m_times_since_last_collision[a] = 0;
+	m_times_since_last_collision[b] = 0;
+}
+
+//
+
+void ball_list::add_to_hash(state_hasher& hasher) const
+{
+	hasher.add(m_size);
+	for (usize i = 0; i < m_size; ++i) {
+		hasher.add(m_xs[i]);
+		hasher.add(m_ys[i]);
+		hasher.add(m_vxs[i]);
+		hasher.add(m_vys[i]);
+		hasher.add(m_radii[i]);
+		hasher.add(m_ages[i]);
 	}
 }
 
 //
 
-bool colliding(const ball& a, const ball& b)
+void ball_list::add_to_renderer(renderer& renderer, float hue, float alpha) const
 {
-	return tr::intersecting(a.hitbox(), b.hitbox()) && glm::dot(a.hitbox().c - b.hitbox().c, b.velocity() - a.velocity()) >= 0;
+	const tr::rgb8 tint{tr::color_cast<tr::rgb8>(tr::hsv{hue, 1, 1})};
+	for (usize i = 0; i < m_size; ++i) {
+		const glm::vec2 pos{interpolated_pos(i, alpha)};
+		add_to_renderer(renderer, i, pos, tint);
+		add_trail_to_renderer(renderer, i, pos, hue);
+	}
 }
 
-void handle_collision(ball& a, ball& b)
+glm::vec2 ball_list::interpolated_pos(usize i, float alpha) const
 {
-	const glm::vec2 dist_vec{a.m_hitbox.c - b.m_hitbox.c};
-	const glm::vec2 vel_diff{a.m_velocity - b.m_velocity};
-	const float dist2{dist_vec.x * dist_vec.x + dist_vec.y * dist_vec.y};
-	const glm::vec2 impulse_vec{glm::dot(dist_vec, vel_diff) / dist2 * dist_vec};
-	const float a_mass{a.m_hitbox.r};
-	const float b_mass{b.m_hitbox.r};
-	const float total_mass{a_mass + b_mass};
+	// The head of the trail is always the position the ball had before the latest tick (intangible balls don't move).
+	return glm::mix(m_trails[i][0], glm::vec2{m_xs[i], m_ys[i]}, alpha);
+}
 
-	play_ball_sound(b.m_hitbox.c + dist_vec / 2.0f, std::max(glm::length(a.m_velocity), glm::length(b.m_velocity)));
+void ball_list::add_to_renderer(renderer& renderer, usize index, glm::vec2 pos, tr::rgb8 tint) const
+{
+	const float raw_age_factor{std::min(float(m_ages[index]) / BALL_SPAWN_ANIMATION_TIME, 1.0f)};
+	const float eased_age_factor{raw_age_factor == 1.0f ? raw_age_factor : 1.0f - std::pow(2.0f, -10.0f * raw_age_factor)};
+	const float size{m_radii[index] * (5 - 4 * eased_age_factor)};
+	const u8 base_opacity{tr::norm_cast<u8>(raw_age_factor)};
+	const float thickness{
+		3 + 4 * std::max((float(BALL_COLLISION_ANIMATION_TIME) - m_times_since_last_collision[index]) / BALL_COLLISION_ANIMATION_TIME, 0.0f),
+	};
 
-	a.m_velocity -= 2 * b_mass / total_mass * impulse_vec;
-	b.m_velocity -= 2 * a_mass / total_mass * -impulse_vec;
+	renderer.circle().add_outlined_circle(layer::BALLS, {pos, size}, thickness, tr::rgba8{0, 0, 0, base_opacity},
+										  tr::rgba8{tint, base_opacity});
+}
+
+void ball_list::add_trail_to_renderer(renderer& renderer, usize index, glm::vec2 pos, float hue) const
+{
+	if (m_ages[index] <= BALL_SPAWN_ANIMATION_TIME) {
+		return;
+	}
 
-	a.m_time_since_last_collision = 0;
-	b.m_time_since_last_collision = 0;
+	const trail& trail{m_trails[index]};
+	glm::vec2 prev_point{pos};
+	float prev_opacity{0.4f};
+	for (usize i = 0; i < TRAIL_SIZE; ++i) {
+		// Cull unnecessary trail segments.
+		if (i < TRAIL_SIZE - 1) {
+			const glm::vec2 prev{i == 0 ? pos : trail[i - 1]};
+			if (tr::collinear(prev, trail[i], trail[i + 1])) {
+				continue;
+			}
+		}
+
+		const float opacity{(TRAIL_SIZE - i - 1) * 0.4f / TRAIL_SIZE};
+		renderer.trails().add_segment(prev_point, trail[i], m_radii[index], prev_opacity, opacity, hue);
+		prev_point = trail[i];
+		prev_opacity = opacity;
+	}
 }
\ No newline at end of file
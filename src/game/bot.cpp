@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements game/bot.hpp.                                                                                                              //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/game/bot.hpp"
+#include <numbers>
+
+/////////////////////////////////////////////////////////////////// BOT ///////////////////////////////////////////////////////////////////
+
+bot::bot(const bot_settings& settings)
+	: m_settings{settings}
+{
+}
+
+//
+
+glm::vec2 bot::steer(const tr::circle& player_hitbox, float inertia_factor, const ball_list& balls) const
+{
+	// The player covers a fixed fraction of the remaining distance to its target every tick.
+	const float step{inertia_factor == 0 ? 1.0f : std::min(1 / (1_sf * inertia_factor), 1.0f)};
+	std::array<float, BOT_PREDICTION_SAMPLES> remaining_offsets;
+	for (usize i = 0; i < BOT_PREDICTION_SAMPLES; ++i) {
+		const float time{m_settings.lookahead * (i + 1) / BOT_PREDICTION_SAMPLES};
+		remaining_offsets[i] = std::pow(1 - step, time * 1_sf);
+	}
+
+	glm::vec2 best_target{player_hitbox.c};
+	float least_danger{danger(player_hitbox, player_hitbox.c, remaining_offsets, balls)};
+	for (float reach : {m_settings.reach / 4, m_settings.reach / 2, m_settings.reach}) {
+		for (usize i = 0; i < BOT_DIRECTIONS; ++i) {
+			const glm::vec2 offset{tr::magth(reach, tr::rads(2 * std::numbers::pi_v<float> * i / BOT_DIRECTIONS))};
+			const glm::vec2 target{glm::clamp(player_hitbox.c + offset, glm::vec2{FIELD_MIN + player_hitbox.r},
+											  glm::vec2{FIELD_MAX - player_hitbox.r})};
+			const float target_danger{danger(player_hitbox, target, remaining_offsets, balls)};
+			if (target_danger < least_danger) {
+				best_target = target;
+				least_danger = target_danger;
+			}
+		}
+	}
+	return best_target;
+}
+
+//
+
+float bot::danger(const tr::circle& player_hitbox, glm::vec2 target, std::span<const float, BOT_PREDICTION_SAMPLES> remaining_offsets,
+				  const ball_list& balls) const
+{
+	float danger{m_settings.center_weight * glm::distance(target, glm::vec2{500, 500})};
+	for (usize i = 0; i < BOT_PREDICTION_SAMPLES; ++i) {
+		const float time{m_settings.lookahead * (i + 1) / BOT_PREDICTION_SAMPLES};
+		// Predictions further into the future are less reliable, so they are weighted less.
+		const float weight{1 - 0.5f * i / BOT_PREDICTION_SAMPLES};
+		const glm::vec2 pos{target + (player_hitbox.c - target) * remaining_offsets[i]};
+
+		for (usize j = 0; j < balls.size(); ++j) {
+			const tr::circle hitbox{balls.hitbox(j)};
+			const glm::vec2 ball_pos{tr::mirror_repeat(hitbox.c + balls.velocity(j) * time, glm::vec2{FIELD_MIN + hitbox.r},
+													   glm::vec2{FIELD_MAX - hitbox.r})};
+			const float clearance{glm::distance(pos, ball_pos) - hitbox.r - player_hitbox.r};
+			if (clearance < m_settings.ball_margin) {
+				danger += weight * (m_settings.ball_margin - clearance) * (m_settings.ball_margin - clearance);
+			}
+		}
+
+		// Staying close to the walls leaves the player with fewer ways out.
+		const glm::vec2 wall_clearance{glm::min(pos - FIELD_MIN, FIELD_MAX - pos) - player_hitbox.r};
+		for (float clearance : {wall_clearance.x, wall_clearance.y}) {
+			if (clearance < m_settings.wall_margin) {
+				danger += 0.25f * weight * (m_settings.wall_margin - clearance) * (m_settings.wall_margin - clearance);
+			}
+		}
+	}
+	return danger;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements game/collision_grid.hpp.                                                                                                   //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/game/collision_grid.hpp"
+
+///////////////////////////////////////////////////////////// COLLISION GRID //////////////////////////////////////////////////////////////
+
+collision_grid::collision_grid(const ball_list& balls)
+{
+	// Two balls can only intersect if their centers are less than the sum of their radii apart, so a cell needs to be at least as large
+	// as the largest diameter for the 3x3 neighbourhood of a ball's cell to contain all of its potential collisions.
+	float max_radius{0};
+	for (usize i = 0; i < balls.size(); ++i) {
+		max_radius = std::max(max_radius, balls.hitbox(i).r);
+	}
+	m_cells_per_axis = std::clamp(int(1000 / std::max(2 * max_radius, 1.0f)), 1, MAX_CELLS_PER_AXIS);
+	m_cell_size = 1000.0f / m_cells_per_axis;
+
+	m_heads.fill(NO_BALL);
+	for (usize i = 0; i < balls.size(); ++i) {
+		const glm::ivec2 cell{cell_of(balls.hitbox(i).c)};
+		link(u8(i), u16(cell.y * m_cells_per_axis + cell.x));
+	}
+}
+
+//
+
+void collision_grid::update(u8 index, glm::vec2 pos)
+{
+	const glm::ivec2 cell{cell_of(pos)};
+	const u16 cell_index{u16(cell.y * m_cells_per_axis + cell.x)};
+	if (m_cells[index] != cell_index) {
+		unlink(index);
+		link(index, cell_index);
+	}
+}
+
+const tr::static_vector<u8, MAX_BALLS>& collision_grid::candidates_after(u8 index)
+{
+	const glm::ivec2 cell{m_cells[index] % m_cells_per_axis, m_cells[index] / m_cells_per_axis};
+
+	m_candidates.clear();
+	for (int y = std::max(cell.y - 1, 0); y <= std::min(cell.y + 1, m_cells_per_axis - 1); ++y) {
+		for (int x = std::max(cell.x - 1, 0); x <= std::min(cell.x + 1, m_cells_per_axis - 1); ++x) {
+			for (u8 other = m_heads[y * m_cells_per_axis + x]; other != NO_BALL; other = m_next[other]) {
+				if (other > index) {
+					m_candidates.push_back(other);
+				}
+			}
+		}
+	}
+	std::ranges::sort(m_candidates);
+	return m_candidates;
+}
+
+//
+
+glm::ivec2 collision_grid::cell_of(glm::vec2 pos) const
+{
+	return glm::clamp(glm::ivec2{pos / m_cell_size}, 0, m_cells_per_axis - 1);
+}
+
+void collision_grid::link(u8 index, u16 cell)
+{
+	m_cells[index] = cell;
+	m_prev[index] = NO_BALL;
+	m_next[index] = m_heads[cell];
+	if (m_heads[cell] != NO_BALL) {
+		m_prev[m_heads[cell]] = index;
+	}
+	m_heads[cell] = index;
+}
+
+void collision_grid::unlink(u8 index)
+{
+	if (m_prev[index] != NO_BALL) {
+		m_next[m_prev[index]] = m_next[index];
+	}
+	else {
+		m_heads[m_cells[index]] = m_next[index];
+	}
+	if (m_next[index] != NO_BALL) {
+		m_prev[m_next[index]] = m_prev[index];
+	}
+}
\ No newline at end of file
@@ -76,8 +76,31 @@ void player::update_fragments()
 
 //
 
+player_snapshot player::snapshot() const
+{
+	return {m_hitbox, m_trail, m_fragments, m_invincibility_timer};
+}
+
+void player::restore(const player_snapshot& snapshot)
+{
+	m_hitbox = snapshot.hitbox;
+	m_trail = snapshot.trail;
+	m_fragments = snapshot.fragments;
+	m_invincibility_timer = snapshot.invincibility_timer;
+}
+
+void player::copy_state(const player& source)
+{
+	m_hitbox = source.m_hitbox;
+	m_trail = source.m_trail;
+	m_fragments = source.m_fragments;
+	m_invincibility_timer = source.m_invincibility_timer;
+}
+
+//
+
 void player::add_to_renderer_alive(renderer& renderer, float hue, ticks time_since_start,
-								   const decrementing_timer<0.1_s>& style_cooldown_timer) const
+								   const decrementing_timer<0.1_s>& style_cooldown_timer, float alpha) const
 {
 	if (std::holds_alternative<uninitialized_skin>(m_skin)) {
 		try_loading_skin(renderer.basic());
@@ -88,17 +111,19 @@ void player::add_to_renderer_alive(renderer& renderer, float hue, ticks time_sin
 	const tr::angle rotation{270_deg * time_since_start / 1_s};
 	const float size_offset{3.0f * tr::turns(time_since_start / 2_sf).sin()};
 	const float size{m_hitbox.r + 6 + size_offset};
+	// The head of the trail is always the position the player had before the latest tick.
+	const glm::vec2 pos{glm::mix(m_trail[0], m_hitbox.c, alpha)};
 
 	if (opacity != 0) {
 		if (std::holds_alternative<tr::gfx::texture>(m_skin)) {
-			add_skin_to_renderer(renderer.basic(), opacity, rotation, size * 2);
+			add_skin_to_renderer(renderer.basic(), pos, opacity, rotation, size * 2);
 		}
 		else {
-			add_fill_to_renderer(renderer.basic(), opacity, rotation, size);
-			add_outline_to_renderer(renderer.basic(), tint, opacity, rotation, size);
-			add_trail_to_renderer(renderer.basic(), tint, opacity, rotation, size);
+			add_fill_to_renderer(renderer.basic(), pos, opacity, rotation, size);
+			add_outline_to_renderer(renderer.basic(), pos, tint, opacity, rotation, size);
+			add_trail_to_renderer(renderer.basic(), pos, tint, opacity, rotation, size);
 		}
-		add_style_wave_to_renderer(renderer.circle(), tint, style_cooldown_timer);
+		add_style_wave_to_renderer(renderer.circle(), pos, tint, style_cooldown_timer);
 	}
 }
 
@@ -130,36 +155,38 @@ void player::try_loading_skin(tr::gfx::renderer_2d& renderer) const
 	}
 }
 
-void player::add_skin_to_renderer(tr::gfx::renderer_2d& renderer, u8 opacity, tr::angle rotation, float size) const
+void player::add_skin_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, u8 opacity, tr::angle rotation, float size) const
 {
 	const tr::gfx::simple_textured_mesh_ref skin{renderer.new_textured_fan(layer::PLAYER, 4)};
-	tr::fill_rectangle_vertices(skin.positions.begin(), m_hitbox.c, glm::vec2{size / 2}, glm::vec2{size}, rotation);
+	tr::fill_rectangle_vertices(skin.positions.begin(), pos, glm::vec2{size / 2}, glm::vec2{size}, rotation);
 	tr::fill_rectangle_vertices(skin.uvs.begin(), {{0, 0}, {1, 1}});
 	std::ranges::fill(skin.tints, tr::rgba8{255, 255, 255, opacity});
 }
 
-void player::add_fill_to_renderer(tr::gfx::renderer_2d& renderer, u8 opacity, tr::angle rotation, float size) const
+void player::add_fill_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, u8 opacity, tr::angle rotation, float size) const
 {
 	const tr::gfx::simple_color_mesh_ref fill{renderer.new_color_fan(layer::PLAYER, 6)};
-	tr::fill_regular_polygon_vertices(fill.positions, {m_hitbox.c, size}, rotation);
+	tr::fill_regular_polygon_vertices(fill.positions, {pos, size}, rotation);
 	std::ranges::fill(fill.colors, tr::rgba8{0, 0, 0, opacity});
 }
 
-void player::add_outline_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 tint, u8 opacity, tr::angle rotation, float size) const
+void player::add_outline_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, tr::rgb8 tint, u8 opacity, tr::angle rotation,
+									 float size) const
 {
 	const tr::gfx::simple_color_mesh_ref outline{renderer.new_color_outline(layer::PLAYER, 6)};
-	tr::fill_regular_polygon_outline_vertices(outline.positions, {m_hitbox.c, size}, rotation, 4.0f);
+	tr::fill_regular_polygon_outline_vertices(outline.positions, {pos, size}, rotation, 4.0f);
 	std::fill_n(outline.colors.begin(), 6, tr::rgba8{tint, opacity});
 	std::fill_n(outline.colors.begin() + 6, 6, tr::rgba8{0, 0, 0, opacity});
 }
 
-void player::add_trail_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 tint, u8 opacity, tr::angle rotation, float size) const
+void player::add_trail_to_renderer(tr::gfx::renderer_2d& renderer, glm::vec2 pos, tr::rgb8 tint, u8 opacity, tr::angle rotation,
+								   float size) const
 {
 	constexpr usize VERTICES{6 * (TRAIL_SIZE + 1)};
 	constexpr usize INDICES{tr::polygon_outline_indices(6) * TRAIL_SIZE};
 
 	tr::gfx::color_mesh_ref trail_mesh{renderer.new_color_mesh(layer::PLAYER_TRAIL, VERTICES, INDICES)};
-	tr::fill_regular_polygon_vertices(trail_mesh.positions.begin(), 6, {m_hitbox.c, size}, rotation);
+	tr::fill_regular_polygon_vertices(trail_mesh.positions.begin(), 6, {pos, size}, rotation);
 	std::ranges::fill(trail_mesh.colors, tr::rgba8{tint, opacity});
 
 	std::vector<u16>::iterator indices_it{trail_mesh.indices.begin()};
@@ -181,7 +208,8 @@ void player::add_trail_to_renderer(tr::gfx::renderer_2d& renderer, tr::rgb8 tint
 	}
 }
 
-void player::add_style_wave_to_renderer(tr::gfx::circle_renderer& renderer, tr::rgb8 tint, const decrementing_timer<0.1_s>& timer) const
+void player::add_style_wave_to_renderer(tr::gfx::circle_renderer& renderer, glm::vec2 pos, tr::rgb8 tint,
+										const decrementing_timer<0.1_s>& timer) const
 {
 	if (!timer.active()) {
 		return;
@@ -191,7 +219,7 @@ void player::add_style_wave_to_renderer(tr::gfx::circle_renderer& renderer, tr::
 	const float scale{m_hitbox.r + 10 + std::pow(t, 2.0f) * 40};
 	const u8 opacity{tr::norm_cast<u8>(std::sqrt(1 - t) * 0.75f)};
 
-	renderer.add_circle_outline(layer::PLAYER, {m_hitbox.c, scale}, 2, tr::rgba8{tint, opacity});
+	renderer.add_circle_outline(layer::PLAYER, {pos, scale}, 2, tr::rgba8{tint, opacity});
 }
 
 void player::add_death_wave_to_renderer(tr::gfx::circle_renderer& renderer, tr::rgb8 tint, ticks time_since_game_over) const
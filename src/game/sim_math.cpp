@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements game/sim_math.hpp.                                                                                                         //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/game/sim_math.hpp"
+
+#ifdef BODGE_STRICT_FP
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// 2/π.
+constexpr double TWO_OVER_PI{0.63661977236758134308};
+// The first 33 bits of π/2 (so that multiplying it by a reasonably-sized integer is exact).
+constexpr double HALF_PI_HI{1.57079632673412561417};
+// The remainder of π/2 after HALF_PI_HI.
+constexpr double HALF_PI_LO{6.07710050650619224932e-11};
+// π/2.
+constexpr double HALF_PI{1.57079632679489661923};
+// π/6.
+constexpr double SIXTH_PI{0.52359877559829887308};
+// tan(π/12).
+constexpr double TAN_TWELFTH_PI{0.26794919243112270647};
+// √3.
+constexpr double SQRT_3{1.73205080756887729353};
+
+//////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
+
+// Result of reducing an angle to [-π/4, π/4].
+struct reduced_angle {
+	// The reduced angle.
+	double r;
+	// The quadrant the original angle was in.
+	i64 quadrant;
+};
+
+// Reduces an angle in radians to [-π/4, π/4] (exactly enough for the angles used by the game).
+static reduced_angle reduce(double x)
+{
+	const double k{std::round(x * TWO_OVER_PI)};
+	return {(x - k * HALF_PI_HI) - k * HALF_PI_LO, i64(k) & 3};
+}
+
+// Calculates the sine of an angle in [-π/4, π/4] using its Taylor series.
+static double sin_kernel(double r)
+{
+	const double r2{r * r};
+	return r * (1 + r2 * (-1 / 6.0 + r2 * (1 / 120.0 + r2 * (-1 / 5040.0 + r2 * (1 / 362880.0 + r2 * (-1 / 39916800.0))))));
+}
+
+// Calculates the cosine of an angle in [-π/4, π/4] using its Taylor series.
+static double cos_kernel(double r)
+{
+	const double r2{r * r};
+	return 1 + r2 * (-1 / 2.0 + r2 * (1 / 24.0 + r2 * (-1 / 720.0 + r2 * (1 / 40320.0 + r2 * (-1 / 3628800.0 + r2 * (1 / 479001600.0))))));
+}
+
+// Calculates the sine and cosine of an angle in radians.
+static std::pair<double, double> strict_sincos(double x)
+{
+	const auto [r, quadrant]{reduce(x)};
+	const double s{sin_kernel(r)};
+	const double c{cos_kernel(r)};
+	switch (quadrant) {
+	case 0:
+		return {s, c};
+	case 1:
+		return {c, -s};
+	case 2:
+		return {-s, -c};
+	default:
+		return {-c, s};
+	}
+}
+
+// Calculates the arctangent of a number in [0, 1].
+static double atan_kernel(double x)
+{
+	// atan(x) = π/6 + atan((x√3 - 1) / (x + √3)) brings x into [-tan(π/12), tan(π/12)], where the Taylor series converges quickly.
+	double offset{0};
+	if (x > TAN_TWELFTH_PI) {
+		x = (x * SQRT_3 - 1) / (x + SQRT_3);
+		offset = SIXTH_PI;
+	}
+
+	const double x2{x * x};
+	double sum{0};
+	for (int n = 15; n >= 3; n -= 2) {
+		sum = x2 * ((n % 4 == 1 ? 1.0 : -1.0) / n + sum);
+	}
+	return offset + x * (1 + sum);
+}
+
+// Calculates the angle of a vector in radians.
+static double strict_atan2(double y, double x)
+{
+	if (x == 0 && y == 0) {
+		return 0;
+	}
+
+	const double ax{std::abs(x)};
+	const double ay{std::abs(y)};
+	double angle{ay <= ax ? atan_kernel(ay / ax) : HALF_PI - atan_kernel(ax / ay)};
+	if (x < 0) {
+		angle = 2 * HALF_PI - angle;
+	}
+	return y < 0 ? -angle : angle;
+}
+
+#endif
+
+///////////////////////////////////////////////////////////// SIMULATION MATH /////////////////////////////////////////////////////////////
+
+glm::vec2 sim_magth(float magnitude, tr::angle th)
+{
+#ifdef BODGE_STRICT_FP
+	const auto [s, c]{strict_sincos(th.rads())};
+	return {magnitude * float(c), magnitude * float(s)};
+#else
+	return tr::magth(magnitude, th);
+#endif
+}
+
+glm::vec2 sim_random_vector(tr::xorshiftr_128p& rng, float magnitude)
+{
+#ifdef BODGE_STRICT_FP
+	return sim_magth(magnitude, rng.generate_angle());
+#else
+	return rng.generate_vector(magnitude);
+#endif
+}
+
+tr::angle sim_atan2(float y, float x)
+{
+#ifdef BODGE_STRICT_FP
+	return tr::rads(float(strict_atan2(y, x)));
+#else
+	return tr::atan2(y, x);
+#endif
+}
+
+glm::vec2 sim_rotate_around(glm::vec2 point, glm::vec2 center, tr::angle th)
+{
+#ifdef BODGE_STRICT_FP
+	const auto [s, c]{strict_sincos(th.rads())};
+	const glm::vec2 offset{point - center};
+	return {center.x + (offset.x * float(c) - offset.y * float(s)), center.y + (offset.x * float(s) + offset.y * float(c))};
+#else
+	return tr::rotate_around(1.0f, center, th) * point;
+#endif
+}
+
+float sim_pow_1_5(float x)
+{
+#ifdef BODGE_STRICT_FP
+	return x * std::sqrt(x);
+#else
+	return std::pow(x, 1.5f);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements game_thread.hpp.                                                                                                           //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../include/game_thread.hpp"
+#include "../include/settings.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// How far behind schedule the simulation can fall before it gives up on catching up (e.g. after the process was suspended).
+constexpr std::chrono::milliseconds MAX_SIMULATION_LAG{100};
+
+/////////////////////////////////////////////////////////////// GAME THREAD ///////////////////////////////////////////////////////////////
+
+game_thread::game_thread(std::shared_ptr<game> game)
+	: m_game{std::move(game)}
+	, m_active_game{dynamic_cast<active_game*>(m_game.get())}
+	, m_replay_game{dynamic_cast<replay_game*>(m_game.get())}
+	, m_frames{*m_game,
+			   m_replay_game != nullptr && m_replay_game->done(),
+			   m_replay_game != nullptr ? m_replay_game->cursor_pos() : glm::vec2{},
+			   m_replay_game != nullptr ? m_replay_game->first_desync() : std::nullopt,
+			   std::chrono::steady_clock::now(),
+			   std::chrono::duration<float>{1.0f / SECOND_TICKS}}
+	, m_mouse_x{500}
+	, m_mouse_y{500}
+	, m_thread{[this](std::stop_token stop_token) { run(std::move(stop_token)); }}
+{
+}
+
+//
+
+const game& game_thread::frame() const
+{
+	return m_frames.read_buffer().snapshot;
+}
+
+bool game_thread::replay_done() const
+{
+	return m_frames.read_buffer().replay_done;
+}
+
+glm::vec2 game_thread::replay_cursor_pos() const
+{
+	return m_frames.read_buffer().replay_cursor_pos;
+}
+
+std::optional<usize> game_thread::replay_first_desync() const
+{
+	return m_frames.read_buffer().replay_first_desync;
+}
+
+float game_thread::interpolation_factor() const
+{
+	const frame_data& frame{m_frames.read_buffer()};
+	const std::chrono::duration<float> since_published{std::chrono::steady_clock::now() - frame.publish_time};
+	return std::min(since_published / frame.tick_duration, 1.0f);
+}
+
+//
+
+void game_thread::set_speed(float speed)
+{
+	m_speed.store(speed, std::memory_order_relaxed);
+}
+
+void game_thread::set_mouse_pos(glm::vec2 mouse_pos)
+{
+	m_mouse_x.store(mouse_pos.x, std::memory_order_relaxed);
+	m_mouse_y.store(mouse_pos.y, std::memory_order_relaxed);
+}
+
+//
+
+void game_thread::update()
+{
+	m_frames.update();
+}
+
+void game_thread::dispatch_events(game_event_sink& sink)
+{
+	// Only the latest screen shake matters, as every one overrides the previous.
+	std::optional<glm::vec2> shake;
+	const usize written{m_events_written.load(std::memory_order_acquire)};
+	usize read{m_events_read.load(std::memory_order_relaxed)};
+	for (; read != written; ++read) {
+		const event& event{m_events[read % GAME_EVENT_QUEUE_SIZE]};
+		if (std::holds_alternative<sound_event>(event)) {
+			const sound_event& sound{std::get<sound_event>(event)};
+			sink.play_sound(sound.sound, sound.volume, sound.pan, sound.pitch);
+		}
+		else {
+			shake = std::get<shake_event>(event).offset;
+		}
+	}
+	m_events_read.store(read, std::memory_order_release);
+
+	if (shake.has_value()) {
+		sink.shake_screen(*shake);
+	}
+}
+
+//
+
+void game_thread::play_sound(::sound sound, float volume, float pan, float pitch)
+{
+	pending_sound& pending{m_pending_sounds[int(sound)]};
+	++pending.count;
+	pending.loudest = std::max(pending.loudest, volume);
+	pending.total_volume += volume;
+	pending.weighted_pan += pan * volume;
+	pending.weighted_pitch += pitch * volume;
+}
+
+void game_thread::shake_screen(glm::vec2 offset)
+{
+	m_pending_shake = offset;
+}
+
+void game_thread::queue_pending_events()
+{
+	// Every sound effect is queued at most once per tick. If the queue is full, the requests stay pending and get merged with the ones
+	// from the following ticks instead of being dropped.
+	for (int i = 0; i < int(sound::COUNT); ++i) {
+		const pending_sound& pending{m_pending_sounds[i]};
+		if (pending.count == 0) {
+			continue;
+		}
+		const float volume{std::min(pending.total_volume, pending.loudest * MAX_MERGED_VOLUME_GAIN)};
+		const float pan{pending.total_volume > 0 ? pending.weighted_pan / pending.total_volume : 0.0f};
+		const float pitch{pending.total_volume > 0 ? pending.weighted_pitch / pending.total_volume : 1.0f};
+		if (push_event(sound_event{::sound(i), volume, pan, pitch})) {
+			m_pending_sounds[i] = {};
+		}
+	}
+	if (m_pending_shake.has_value() && push_event(shake_event{*m_pending_shake})) {
+		m_pending_shake.reset();
+	}
+}
+
+bool game_thread::push_event(const event& event)
+{
+	const usize written{m_events_written.load(std::memory_order_relaxed)};
+	if (written - m_events_read.load(std::memory_order_acquire) >= GAME_EVENT_QUEUE_SIZE) {
+		return false;
+	}
+	m_events[written % GAME_EVENT_QUEUE_SIZE] = event;
+	m_events_written.store(written + 1, std::memory_order_release);
+	return true;
+}
+
+//
+
+void game_thread::publish_frame(std::chrono::duration<float> tick_duration)
+{
+	frame_data& frame{m_frames.write_buffer()};
+	frame.snapshot.copy_state(*m_game);
+	if (m_replay_game != nullptr) {
+		frame.replay_done = m_replay_game->done();
+		frame.replay_cursor_pos = m_replay_game->cursor_pos();
+		frame.replay_first_desync = m_replay_game->first_desync();
+	}
+	frame.publish_time = std::chrono::steady_clock::now();
+	frame.tick_duration = tick_duration;
+	m_frames.publish();
+}
+
+void game_thread::run(std::stop_token stop_token)
+{
+	using clock = std::chrono::steady_clock;
+
+	clock::time_point next_tick{clock::now()};
+	while (!stop_token.stop_requested()) {
+		if (m_active_game != nullptr) {
+			m_active_game->tick({m_mouse_x.load(std::memory_order_relaxed), m_mouse_y.load(std::memory_order_relaxed)}, *this);
+		}
+		else {
+			m_game->tick(*this);
+		}
+		queue_pending_events();
+
+		const float rate{SECOND_TICKS * debug_settings::instance().game_speed() * m_speed.load(std::memory_order_relaxed)};
+		const std::chrono::duration<float> tick_duration{1 / rate};
+		publish_frame(tick_duration);
+		next_tick += std::chrono::duration_cast<clock::duration>(tick_duration);
+		if (const clock::time_point now{clock::now()}; now - next_tick > MAX_SIMULATION_LAG) {
+			next_tick = now;
+		}
+		std::this_thread::sleep_until(next_tick);
+	}
+}
\ No newline at end of file
@@ -194,6 +194,15 @@ gamemode pick_menu_gamemode()
 	return MENU_GAMEMODES[g_rng.generate(MENU_GAMEMODES.size())];
 }
 
+gamemode load_gamemode(const std::filesystem::path& path)
+{
+	std::ifstream is{tr::open_file_r(path, std::ios::binary)};
+	if (tr::binary_read<u8>(is) != GAMEMODE_VERSION) {
+		throw std::runtime_error{"Unsupported gamemode version."};
+	}
+	return tr::binary_read<gamemode>(tr::decrypt(tr::flush_binary(is)));
+}
+
 std::vector<gamemode_with_path> load_gamemodes(const std::filesystem::path& directory)
 {
 	std::vector<gamemode_with_path> gamemodes;
@@ -208,10 +217,7 @@ std::vector<gamemode_with_path> load_gamemodes(const std::filesystem::path& dire
 					continue;
 				}
 
-				std::ifstream is{tr::open_file_r(path, std::ios::binary)};
-				if (tr::binary_read<u8>(is) == GAMEMODE_VERSION) {
-					gamemodes.emplace_back(path.string(), tr::binary_read<gamemode>(tr::decrypt(tr::flush_binary(is))));
-				}
+				gamemodes.emplace_back(path.string(), load_gamemode(path));
 			}
 			catch (std::exception&) {
 				continue;
@@ -10,13 +10,33 @@
 
 std::string format_score(i64 score)
 {
-	return TR_FMT::format("{:05}", score);
+	number_buffer buffer;
+	return std::string{format_score(buffer, score)};
+}
+
+std::string_view format_score(number_buffer& buffer, i64 score)
+{
+	const auto result{TR_FMT::format_to_n(buffer.data(), buffer.size(), "{:05}", score)};
+	return {buffer.data(), result.out};
 }
 
 std::string format_time(ticks time)
 {
-	return {time >= 60_s ? TR_FMT::format("{}:{:02}:{:02}", time / 60_s, (time % 60_s) / 1_s, (time % 1_s) * 100 / 1_s)
-						 : TR_FMT::format("{:02}:{:02}", time / 1_s, (time % 1_s) * 100 / 1_s)};
+	number_buffer buffer;
+	return std::string{format_time(buffer, time)};
+}
+
+std::string_view format_time(number_buffer& buffer, ticks time)
+{
+	if (time >= 60_s) {
+		const auto result{TR_FMT::format_to_n(buffer.data(), buffer.size(), "{}:{:02}:{:02}", time / 60_s, (time % 60_s) / 1_s,
+											  (time % 1_s) * 100 / 1_s)};
+		return {buffer.data(), result.out};
+	}
+	else {
+		const auto result{TR_FMT::format_to_n(buffer.data(), buffer.size(), "{:02}:{:02}", time / 1_s, (time % 1_s) * 100 / 1_s)};
+		return {buffer.data(), result.out};
+	}
 }
 
 std::string format_time_long(ticks time)
@@ -44,6 +64,13 @@ i64 current_timestamp()
 
 //
 
+u64 state_hasher::value() const
+{
+	return m_hash;
+}
+
+//
+
 void fragment::tick()
 {
 	pos += vel / 1_sf;
@@ -0,0 +1,766 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements headless.hpp.                                                                                                              //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../include/headless.hpp"
+#include "../include/game.hpp"
+#include "../include/game/sim_math.hpp"
+#include "../include/input.hpp"
+#include <atomic>
+#include <charconv>
+#include <map>
+#include <numeric>
+#include <thread>
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Seed used by all benchmark games.
+constexpr u64 BENCHMARK_SEED{0x426F64676542656E};
+// Number of ticks each benchmark case is run for.
+constexpr ticks BENCHMARK_TICKS{120_s};
+// Interval between printed state hashes in the conformance check.
+constexpr ticks CONFORMANCE_HASH_INTERVAL{10_s};
+// Time after which games are cut off in batch simulations.
+constexpr ticks BATCH_SIMULATION_TIME_LIMIT{30 * 60_s};
+// Interval between samples of the number of balls in batch simulations.
+constexpr ticks BALL_COUNT_SAMPLE_INTERVAL{5_s};
+// Interval between the reports printed by the soak test.
+constexpr ticks SOAK_REPORT_INTERVAL{60_s};
+#ifdef BODGE_ALLOCATION_TRACKING
+// Whether heap allocations are counted.
+constexpr bool ALLOCATION_TRACKING{true};
+#else
+// Whether heap allocations are counted.
+constexpr bool ALLOCATION_TRACKING{false};
+#endif
+
+/////////////////////////////////////////////////////////// ALLOCATION COUNTING ///////////////////////////////////////////////////////////
+
+// Number of heap allocations made by the current thread (always 0 if allocations aren't tracked).
+static thread_local usize t_allocations{0};
+// Number of heap deallocations made by the current thread (always 0 if allocations aren't tracked).
+static thread_local usize t_deallocations{0};
+
+// The global allocator is only replaced in builds made for the headless checks, not in the game players run.
+#ifdef BODGE_ALLOCATION_TRACKING
+void* operator new(std::size_t size)
+{
+	++t_allocations;
+	if (void* ptr{std::malloc(size == 0 ? 1 : size)}; ptr != nullptr) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+	t_deallocations += ptr != nullptr;
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	t_deallocations += ptr != nullptr;
+	std::free(ptr);
+}
+#endif
+
+//////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
+
+// Result of verifying a replay.
+struct replay_verification_result {
+	// Whether the replay was successfully loaded.
+	bool loaded{false};
+	// The score recorded in the replay's header.
+	i64 expected_score{0};
+	// The time recorded in the replay's header.
+	ticks expected_time{0};
+	// The score achieved by re-simulating the replay.
+	i64 actual_score{0};
+	// The time achieved by re-simulating the replay.
+	ticks actual_time{0};
+	// The number of simulated ticks.
+	usize simulated_ticks{0};
+	// The number of inputs after which the game state first didn't match the recorded one (if a desync was detected).
+	std::optional<usize> first_desync;
+	// The error that stopped the replay from being loaded or simulated (empty if there was none).
+	std::string error;
+
+	// Gets whether the replay was verified successfully.
+	bool passed() const;
+};
+
+bool replay_verification_result::passed() const
+{
+	return loaded && error.empty() && actual_score == expected_score && actual_time == expected_time && !first_desync.has_value();
+}
+
+// Gets the paths of all replay files in a directory in alphabetical order.
+static std::vector<std::filesystem::path> replay_paths(const std::filesystem::path& directory)
+{
+	std::vector<std::filesystem::path> paths;
+	for (std::filesystem::directory_entry file : std::filesystem::directory_iterator{directory}) {
+		if (file.is_regular_file() && file.path().extension() == ".dat") {
+			paths.push_back(file.path());
+		}
+	}
+	std::ranges::sort(paths);
+	return paths;
+}
+
+// Re-simulates a replay to its end.
+static replay_verification_result verify_replay(const std::filesystem::path& path, const savefile_snapshot& savefile)
+{
+	replay_verification_result result{};
+	std::optional<replay> rpy;
+	try {
+		rpy.emplace(path);
+	}
+	catch (std::exception& err) {
+		result.error = err.what();
+		return result;
+	}
+	result.loaded = true;
+	result.expected_score = rpy->header().score;
+	result.expected_time = rpy->header().time;
+
+	// Errors past this point happen during playback, so they're reported separately along with how far the simulation got.
+	try {
+		replay_game game{std::move(*rpy), savefile};
+		null_event_sink events;
+		while (!game.done()) {
+			game.tick(events);
+			++result.simulated_ticks;
+		}
+		result.actual_score = game.final_score();
+		result.actual_time = game.final_time();
+		result.first_desync = game.first_desync();
+	}
+	catch (std::exception& err) {
+		result.error = err.what();
+	}
+	return result;
+}
+
+// Prints the result of verifying a replay.
+static void print_result(const std::filesystem::path& path, const replay_verification_result& result)
+{
+	const std::string filename{path.filename().string()};
+	if (!result.loaded) {
+		std::cout << TR_FMT::format("[FAIL] {}: Failed to load replay: {}\n", filename, result.error);
+	}
+	else if (!result.error.empty()) {
+		std::cout << TR_FMT::format("[FAIL] {}: Simulation failed after {} ticks: {}\n", filename, result.simulated_ticks, result.error);
+	}
+	else if (!result.passed()) {
+		std::cout << TR_FMT::format("[FAIL] {}: Expected {} in {}, got {} in {}.", filename, format_score(result.expected_score),
+									format_time_long(result.expected_time), format_score(result.actual_score),
+									format_time_long(result.actual_time));
+		if (result.first_desync.has_value()) {
+			std::cout << TR_FMT::format(" Desync first detected at tick {} ({}).", *result.first_desync,
+										format_time_long(ticks(*result.first_desync)));
+		}
+		std::cout << "\n";
+	}
+	else {
+		std::cout << TR_FMT::format("[ OK ] {}: {} in {}.\n", filename, format_score(result.actual_score),
+									format_time_long(result.actual_time));
+	}
+}
+
+// Gets the input of a scripted game at a point in time, following a fixed pattern sweeping across the field.
+static glm::vec2 scripted_input(ticks elapsed)
+{
+	// The simulation's own math is used so that the input doesn't differ between builds in the conformance check.
+	const float t{elapsed / 1_sf};
+	return {500 + sim_magth(350, tr::rads(0.7f * t)).y, 500 + sim_magth(350, tr::rads(1.1f * t)).y};
+}
+
+// Game whose input follows a fixed pattern sweeping across the field.
+class scripted_game final : public game {
+  public:
+	// Creates a scripted game.
+	scripted_game(::gamemode gamemode, u64 seed);
+
+	// Updates the game.
+	void tick(game_event_sink& events) override;
+
+  private:
+	// The number of elapsed ticks.
+	ticks m_elapsed{0};
+};
+
+scripted_game::scripted_game(::gamemode gamemode, u64 seed)
+	: game{different_player_result_color_picker{}, std::move(gamemode), seed}
+{
+}
+
+void scripted_game::tick(game_event_sink& events)
+{
+	game::tick(scripted_input(m_elapsed++), events);
+}
+
+// Active game (recording a replay like the games players play) whose input follows the same pattern as a scripted game.
+class scripted_active_game {
+  public:
+	// Creates a scripted active game recording its replay in a directory.
+	scripted_active_game(::gamemode gamemode, u64 seed, const std::filesystem::path& replay_directory);
+
+	// Updates the game.
+	void tick(game_event_sink& events);
+
+  private:
+	// Input manager required by the active game (never read, as the input is passed in directly).
+	input m_input;
+	// The underlying active game.
+	active_game m_game;
+	// The number of elapsed ticks.
+	ticks m_elapsed{0};
+};
+
+scripted_active_game::scripted_active_game(::gamemode gamemode, u64 seed, const std::filesystem::path& replay_directory)
+	: m_game{m_input, std::make_shared<const savefile>(replay_directory / "savefile.dat"), std::move(gamemode), seed, replay_directory}
+{
+}
+
+void scripted_active_game::tick(game_event_sink& events)
+{
+	m_game.tick(scripted_input(m_elapsed++), events);
+}
+
+// Result of a benchmark case.
+struct benchmark_result {
+	// The name of the benchmark case.
+	std::string name;
+	// The mean duration of a tick in nanoseconds.
+	double mean_ns;
+	// The median duration of a tick in nanoseconds.
+	i64 p50_ns;
+	// The 90th percentile of tick durations in nanoseconds.
+	i64 p90_ns;
+	// The 99th percentile of tick durations in nanoseconds.
+	i64 p99_ns;
+	// The longest tick duration in nanoseconds.
+	i64 max_ns;
+	// The average number of heap allocations per tick.
+	double allocations_per_tick;
+};
+
+// Runs a game for a fixed number of ticks and measures it.
+static benchmark_result run_benchmark(std::string name, auto& game)
+{
+	null_event_sink events;
+	std::vector<i64> durations(BENCHMARK_TICKS);
+	usize allocations{0};
+	for (i64& duration : durations) {
+		const usize allocations_before{t_allocations};
+		const auto start{std::chrono::steady_clock::now()};
+		game.tick(events);
+		duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		allocations += t_allocations - allocations_before;
+	}
+
+	const double mean_ns{std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size()};
+	std::ranges::sort(durations);
+	const auto percentile{[&](usize p) { return durations[std::min(durations.size() * p / 100, durations.size() - 1)]; }};
+	return {
+		std::move(name), mean_ns, percentile(50), percentile(90), percentile(99), durations.back(), double(allocations) / durations.size(),
+	};
+}
+
+// State hash of a conformance check case at a point in time.
+struct conformance_hash {
+	// The name of the case.
+	std::string name;
+	// The time the hash was taken at.
+	ticks time;
+	// The hash of the simulation state.
+	u64 hash;
+};
+
+// Reference state hashes of the conformance check, keyed by case name and time.
+using conformance_reference = std::map<std::pair<std::string, ticks>, u64>;
+
+// Runs a game for a fixed number of ticks, printing and storing the hash of its state at regular intervals.
+static void run_conformance_case(const std::string& name, auto& game, std::vector<conformance_hash>& hashes)
+{
+	null_event_sink events;
+	for (ticks time = 1; time <= BENCHMARK_TICKS; ++time) {
+		game.tick(events);
+		if (time % CONFORMANCE_HASH_INTERVAL == 0) {
+			std::cout << TR_FMT::format("{} {} {:016X}\n", name, format_time_long(time), game.state_hash());
+			hashes.push_back({name, time, game.state_hash()});
+		}
+	}
+}
+
+// Reads the reference hashes of the conformance check from a file of "<case> <tick> <hash>" lines ('#' starts a comment line).
+static conformance_reference read_conformance_reference(const std::filesystem::path& path)
+{
+	std::ifstream file{tr::open_file_r(path, std::ios::binary)};
+	conformance_reference hashes;
+	for (std::string line; std::getline(file, line);) {
+		if (line.ends_with('\r')) {
+			line.pop_back();
+		}
+		if (line.empty() || line.starts_with('#')) {
+			continue;
+		}
+
+		const usize hash_start{line.rfind(' ') + 1};
+		const usize time_start{hash_start > 1 ? line.rfind(' ', hash_start - 2) + 1 : 0};
+		ticks time{};
+		u64 hash{};
+		if (time_start == 0 || std::from_chars(line.data() + time_start, line.data() + hash_start - 1, time).ec != std::errc{} ||
+			std::from_chars(line.data() + hash_start, line.data() + line.size(), hash, 16).ec != std::errc{}) {
+			throw std::runtime_error{TR_FMT::format("Malformed line '{}'.", line)};
+		}
+		hashes.emplace(std::pair{line.substr(0, time_start - 1), time}, hash);
+	}
+	return hashes;
+}
+
+// Writes the reference hashes of the conformance check to a file.
+static void write_conformance_reference(const std::filesystem::path& path, std::span<const conformance_hash> hashes)
+{
+	std::ofstream file{tr::open_file_w(path, std::ios::binary)};
+	file << "# Reference state hashes of the Bodge conformance check, recorded with a strict floating-point build.\n"
+			"# Check a build against them with --conformance <file>, record them with --conformance <file> --record.\n";
+	for (const auto& [name, time, hash] : hashes) {
+		file << TR_FMT::format("{} {} {:016X}\n", name, time, hash);
+	}
+}
+
+// Runs a game for a fixed number of ticks, reporting any heap allocations made while ticking. Returns whether there were none.
+static bool run_allocation_check_case(std::string_view name, auto& game)
+{
+	null_event_sink events;
+	usize allocations{0};
+	usize allocating_ticks{0};
+	ticks first_allocating_tick{0};
+	for (ticks time = 1; time <= BENCHMARK_TICKS; ++time) {
+		const usize allocations_before{t_allocations};
+		game.tick(events);
+		if (t_allocations != allocations_before) {
+			allocations += t_allocations - allocations_before;
+			if (allocating_ticks++ == 0) {
+				first_allocating_tick = time;
+			}
+		}
+	}
+
+	if (allocating_ticks == 0) {
+		std::cout << TR_FMT::format("[ OK ] {}: No allocations in {} ticks.\n", name, BENCHMARK_TICKS);
+	}
+	else {
+		std::cout << TR_FMT::format("[FAIL] {}: {} allocations in {} ticks, first at {}.\n", name, allocations, allocating_ticks,
+									format_time_long(first_allocating_tick));
+	}
+	return allocating_ticks == 0;
+}
+
+// Creates a stress-test variant of a gamemode with the maximum number of balls.
+static gamemode stress_gamemode(gamemode gamemode)
+{
+	gamemode.name = "stress";
+	gamemode.player.starting_lives = 255;
+	gamemode.ball.starting_count = MAX_BALLS;
+	gamemode.ball.max_count = MAX_BALLS;
+	return gamemode;
+}
+
+// Result of a game simulated in a batch simulation.
+struct simulated_game_result {
+	// The time the game lasted.
+	ticks time;
+	// The final score of the game.
+	i64 score;
+	// The number of simulated ticks.
+	usize simulated_ticks;
+	// Whether the game was cut off by the time limit.
+	bool cut_off;
+	// Whether the ball count reached the gamemode's maximum before the game ended.
+	bool reached_max_balls;
+	// The number of balls sampled every BALL_COUNT_SAMPLE_INTERVAL.
+	std::vector<u8> ball_counts;
+};
+
+// Simulates a game until it ends or is cut off by the time limit.
+template <class Game> static simulated_game_result simulate_game(const gamemode& gamemode, u64 seed)
+{
+	Game game{gamemode, seed};
+	null_event_sink events;
+	std::vector<u8> ball_counts;
+	ball_counts.reserve(BATCH_SIMULATION_TIME_LIMIT / BALL_COUNT_SAMPLE_INTERVAL + 1);
+	ticks time{0};
+	bool reached_max_balls{false};
+	for (; !game.game_over() && time < BATCH_SIMULATION_TIME_LIMIT; ++time) {
+		if (time % BALL_COUNT_SAMPLE_INTERVAL == 0) {
+			ball_counts.push_back(u8(game.ball_count()));
+		}
+		game.tick(events);
+		reached_max_balls |= game.ball_count() >= gamemode.ball.max_count;
+	}
+	return {game.final_time(), game.final_score(), time, !game.game_over(), reached_max_balls, std::move(ball_counts)};
+}
+
+// Function simulating a game with a certain input policy.
+using game_simulator = simulated_game_result (*)(const gamemode& gamemode, u64 seed);
+
+// Gets the function simulating games with an input policy (nullptr if there is no such policy).
+static game_simulator find_game_simulator(std::string_view policy)
+{
+	if (policy == "scripted") {
+		return simulate_game<scripted_game>;
+	}
+	else if (policy == "bot") {
+		return simulate_game<bot_game>;
+	}
+	return nullptr;
+}
+
+// Formats a summary of the distribution of a non-empty set of values as a JSON object.
+static std::string format_distribution(std::vector<double> values)
+{
+	const double mean{std::accumulate(values.begin(), values.end(), 0.0) / values.size()};
+	std::ranges::sort(values);
+	const auto percentile{[&](usize p) { return values[std::min(values.size() * p / 100, values.size() - 1)]; }};
+	return TR_FMT::format("{{\"mean\": {:.2f}, \"min\": {:.2f}, \"p10\": {:.2f}, \"p25\": {:.2f}, \"p50\": {:.2f}, \"p75\": {:.2f}, "
+						  "\"p90\": {:.2f}, \"max\": {:.2f}}}",
+						  mean, values.front(), percentile(10), percentile(25), percentile(50), percentile(75), percentile(90),
+						  values.back());
+}
+
+/////////////////////////////////////////////////////////// REPLAY VERIFICATION ///////////////////////////////////////////////////////////
+
+tr::sys::signal verify_replays(const std::filesystem::path& directory)
+{
+	std::vector<std::filesystem::path> paths;
+	try {
+		paths = replay_paths(directory);
+	}
+	catch (std::exception& err) {
+		std::cout << TR_FMT::format("Failed to read replay directory: {}\n", err.what());
+		return tr::sys::signal::FAILURE;
+	}
+
+	// The savefile is only used to pick result colors, so it's loaded once and shared by all replays.
+	const savefile_snapshot savefile{std::make_shared<const ::savefile>()};
+	// Replays are handed out to the workers one at a time, as their lengths can vary greatly.
+	std::vector<replay_verification_result> results(paths.size());
+	std::atomic<usize> next_replay{0};
+	const usize thread_count{std::clamp(usize(std::thread::hardware_concurrency()), 1_uz, std::max(paths.size(), 1_uz))};
+	const auto start{std::chrono::steady_clock::now()};
+	{
+		std::vector<std::jthread> workers;
+		for (usize i = 0; i < thread_count; ++i) {
+			workers.emplace_back([&] {
+				for (usize index = next_replay++; index < paths.size(); index = next_replay++) {
+					results[index] = verify_replay(paths[index], savefile);
+				}
+			});
+		}
+	}
+	const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+	usize passed{0};
+	usize simulated_ticks{0};
+	for (usize i = 0; i < paths.size(); ++i) {
+		print_result(paths[i], results[i]);
+		passed += results[i].passed();
+		simulated_ticks += results[i].simulated_ticks;
+	}
+	const double ticks_per_second{elapsed.count() > 0 ? simulated_ticks / elapsed.count() : 0.0};
+	std::cout << TR_FMT::format("{}/{} replays verified.\n", passed, paths.size());
+	std::cout << TR_FMT::format("Simulated {} ticks in {:.3f}s on {} threads ({:.0f} ticks/s, {:.1f}x realtime).\n", simulated_ticks,
+								elapsed.count(), thread_count, ticks_per_second, ticks_per_second / SECOND_TICKS);
+	return passed == paths.size() ? tr::sys::signal::SUCCESS : tr::sys::signal::FAILURE;
+}
+
+/////////////////////////////////////////////////////////////// BENCHMARKS ////////////////////////////////////////////////////////////////
+
+tr::sys::signal run_benchmarks()
+{
+	std::vector<gamemode> gamemodes{BUILTIN_GAMEMODES.begin(), BUILTIN_GAMEMODES.end()};
+	gamemodes.push_back(stress_gamemode(BUILTIN_GAMEMODES[0]));
+
+	std::vector<benchmark_result> results;
+	for (const gamemode& gamemode : gamemodes) {
+		playerless_game playerless{gamemode, BENCHMARK_SEED};
+		results.push_back(run_benchmark(TR_FMT::format("playerless/{}", gamemode.name), playerless));
+		scripted_game scripted{gamemode, BENCHMARK_SEED};
+		results.push_back(run_benchmark(TR_FMT::format("game/{}", gamemode.name), scripted));
+	}
+
+	std::cout << TR_FMT::format("{{\n  \"version\": \"{}\",\n  \"seed\": {},\n  \"ticks\": {},\n  \"benchmarks\": [\n", VERSION_STRING,
+								BENCHMARK_SEED, BENCHMARK_TICKS);
+	for (usize i = 0; i < results.size(); ++i) {
+		const benchmark_result& result{results[i]};
+		std::cout << TR_FMT::format("    {{\"name\": \"{}\", \"mean_ns\": {:.1f}, \"p50_ns\": {}, \"p90_ns\": {}, \"p99_ns\": {}, "
+									"\"max_ns\": {}, \"allocations_per_tick\": {}}}{}\n",
+									result.name, result.mean_ns, result.p50_ns, result.p90_ns, result.p99_ns, result.max_ns,
+									ALLOCATION_TRACKING ? TR_FMT::format("{:.3f}", result.allocations_per_tick) : "null",
+									i < results.size() - 1 ? "," : "");
+	}
+	std::cout << "  ]\n}\n";
+	return tr::sys::signal::SUCCESS;
+}
+
+//////////////////////////////////////////////////////////// CONFORMANCE CHECK ////////////////////////////////////////////////////////////
+
+tr::sys::signal run_conformance_check(const std::filesystem::path& reference_path, bool record)
+{
+	std::vector<gamemode> gamemodes{BUILTIN_GAMEMODES.begin(), BUILTIN_GAMEMODES.end()};
+	gamemodes.push_back(stress_gamemode(BUILTIN_GAMEMODES[0]));
+
+	conformance_reference reference;
+	if (!record) {
+		try {
+			reference = read_conformance_reference(reference_path);
+		}
+		catch (std::exception& err) {
+			std::cout << TR_FMT::format("Failed to read reference hashes: {}\n", err.what());
+			return tr::sys::signal::FAILURE;
+		}
+	}
+
+#ifdef BODGE_STRICT_FP
+	std::cout << TR_FMT::format("Bodge {} conformance check (strict floating-point simulation).\n", VERSION_STRING);
+#else
+	std::cout << TR_FMT::format("Bodge {} conformance check (legacy floating-point simulation).\n", VERSION_STRING);
+#endif
+	std::vector<conformance_hash> hashes;
+	for (const gamemode& gamemode : gamemodes) {
+		playerless_game playerless{gamemode, BENCHMARK_SEED};
+		run_conformance_case(TR_FMT::format("playerless/{}", gamemode.name), playerless, hashes);
+		scripted_game scripted{gamemode, BENCHMARK_SEED};
+		run_conformance_case(TR_FMT::format("game/{}", gamemode.name), scripted, hashes);
+	}
+
+	if (record) {
+		try {
+			write_conformance_reference(reference_path, hashes);
+		}
+		catch (std::exception& err) {
+			std::cout << TR_FMT::format("Failed to write reference hashes: {}\n", err.what());
+			return tr::sys::signal::FAILURE;
+		}
+		std::cout << TR_FMT::format("Recorded {} reference hashes.\n", hashes.size());
+		return tr::sys::signal::SUCCESS;
+	}
+
+	// The hashes are compared in the order they were taken, so the first mismatch is the earliest divergence of its case.
+	for (const auto& [name, time, hash] : hashes) {
+		const auto it{reference.find({name, time})};
+		if (it == reference.end()) {
+			std::cout << TR_FMT::format("[FAIL] {}: No reference hash at {}.\n", name, format_time_long(time));
+			return tr::sys::signal::FAILURE;
+		}
+		else if (it->second != hash) {
+			std::cout << TR_FMT::format("[FAIL] {}: State hash at {} is {:016X}, expected {:016X}.\n", name, format_time_long(time), hash,
+										it->second);
+			return tr::sys::signal::FAILURE;
+		}
+	}
+	std::cout << TR_FMT::format("[ OK ] All {} state hashes match the reference.\n", hashes.size());
+	return tr::sys::signal::SUCCESS;
+}
+
+//////////////////////////////////////////////////////////// ALLOCATION CHECK /////////////////////////////////////////////////////////////
+
+tr::sys::signal run_allocation_check()
+{
+	if (!ALLOCATION_TRACKING) {
+		std::cout << "Allocations aren't tracked in this build (configure it with -DBODGE_ALLOCATION_TRACKING=ON).\n";
+		return tr::sys::signal::FAILURE;
+	}
+
+	std::vector<gamemode> gamemodes{BUILTIN_GAMEMODES.begin(), BUILTIN_GAMEMODES.end()};
+	gamemodes.push_back(stress_gamemode(BUILTIN_GAMEMODES[0]));
+
+	// Active games record their replays into a scratch directory that is removed afterwards.
+	const std::filesystem::path replay_directory{std::filesystem::temp_directory_path() / "bodge_allocation_check"};
+	try {
+		std::filesystem::create_directories(replay_directory);
+	}
+	catch (std::exception& err) {
+		std::cout << TR_FMT::format("Failed to create replay directory: {}\n", err.what());
+		return tr::sys::signal::FAILURE;
+	}
+
+	bool passed{true};
+	for (const gamemode& gamemode : gamemodes) {
+		playerless_game playerless{gamemode, BENCHMARK_SEED};
+		passed &= run_allocation_check_case(TR_FMT::format("playerless/{}", gamemode.name), playerless);
+		scripted_game scripted{gamemode, BENCHMARK_SEED};
+		passed &= run_allocation_check_case(TR_FMT::format("game/{}", gamemode.name), scripted);
+		scripted_active_game active{gamemode, BENCHMARK_SEED, replay_directory};
+		passed &= run_allocation_check_case(TR_FMT::format("active/{}", gamemode.name), active);
+	}
+
+	std::error_code ec;
+	std::filesystem::remove_all(replay_directory, ec);
+	return passed ? tr::sys::signal::SUCCESS : tr::sys::signal::FAILURE;
+}
+
+//////////////////////////////////////////////////////////// BATCH SIMULATION /////////////////////////////////////////////////////////////
+
+tr::sys::signal run_batch_simulation(const std::filesystem::path& gamemode_path, u64 first_seed, usize game_count, std::string_view policy)
+{
+	const game_simulator simulator{find_game_simulator(policy)};
+	if (simulator == nullptr) {
+		std::cout << TR_FMT::format("Unknown input policy '{}'.\n", policy);
+		return tr::sys::signal::FAILURE;
+	}
+	if (game_count == 0) {
+		std::cout << "No games to simulate.\n";
+		return tr::sys::signal::FAILURE;
+	}
+	// Built-in gamemodes don't have files, so they're simulated by name.
+	const std::string name{gamemode_path.string()};
+	const auto builtin{std::ranges::find_if(BUILTIN_GAMEMODES, [&](const gamemode& gm) { return std::string_view{gm.name} == name; })};
+	gamemode gamemode;
+	if (builtin != BUILTIN_GAMEMODES.end()) {
+		gamemode = *builtin;
+	}
+	else {
+		try {
+			gamemode = load_gamemode(gamemode_path);
+		}
+		catch (std::exception& err) {
+			std::cout << TR_FMT::format("Failed to load gamemode: {}\n", err.what());
+			return tr::sys::signal::FAILURE;
+		}
+	}
+
+	// Games are handed out to the workers one at a time, as their lengths can vary greatly.
+	std::vector<simulated_game_result> results(game_count);
+	std::atomic<usize> next_game{0};
+	const usize thread_count{std::clamp(usize(std::thread::hardware_concurrency()), 1_uz, game_count)};
+	const auto start{std::chrono::steady_clock::now()};
+	{
+		std::vector<std::jthread> workers;
+		for (usize i = 0; i < thread_count; ++i) {
+			workers.emplace_back([&] {
+				for (usize index = next_game++; index < game_count; index = next_game++) {
+					results[index] = simulator(gamemode, first_seed + index);
+				}
+			});
+		}
+	}
+	const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+	std::vector<double> times;
+	std::vector<double> scores;
+	usize simulated_ticks{0};
+	usize cut_off_games{0};
+	usize games_at_max_balls{0};
+	// The number of games still running and the sum of their ball counts at every sample.
+	std::vector<std::pair<usize, usize>> ball_count_samples;
+	for (const simulated_game_result& result : results) {
+		times.push_back(double(result.time) / SECOND_TICKS);
+		scores.push_back(double(result.score));
+		simulated_ticks += result.simulated_ticks;
+		cut_off_games += result.cut_off;
+		games_at_max_balls += result.reached_max_balls;
+		for (usize i = 0; i < result.ball_counts.size(); ++i) {
+			if (i == ball_count_samples.size()) {
+				ball_count_samples.emplace_back(0, 0);
+			}
+			++ball_count_samples[i].first;
+			ball_count_samples[i].second += result.ball_counts[i];
+		}
+	}
+	const double ticks_per_second_per_core{elapsed.count() > 0 ? simulated_ticks / elapsed.count() / thread_count : 0.0};
+
+	std::cout << TR_FMT::format("{{\n  \"version\": \"{}\",\n  \"gamemode\": \"{}\",\n  \"policy\": \"{}\",\n", VERSION_STRING,
+								gamemode.name, policy);
+	std::cout << TR_FMT::format("  \"first_seed\": {},\n  \"games\": {},\n  \"threads\": {},\n  \"simulated_ticks\": {},\n", first_seed,
+								game_count, thread_count, simulated_ticks);
+	std::cout << TR_FMT::format("  \"elapsed_s\": {:.3f},\n  \"ticks_per_second_per_core\": {:.0f},\n", elapsed.count(),
+								ticks_per_second_per_core);
+	std::cout << TR_FMT::format("  \"cut_off_games\": {},\n  \"games_at_max_balls\": {},\n", cut_off_games, games_at_max_balls);
+	std::cout << TR_FMT::format("  \"time_s\": {},\n  \"score\": {},\n  \"ball_count\": [\n", format_distribution(std::move(times)),
+								format_distribution(std::move(scores)));
+	for (usize i = 0; i < ball_count_samples.size(); ++i) {
+		const auto [games, ball_sum]{ball_count_samples[i]};
+		std::cout << TR_FMT::format("    {{\"time_s\": {}, \"games\": {}, \"mean\": {:.2f}}}{}\n",
+									i * BALL_COUNT_SAMPLE_INTERVAL / SECOND_TICKS, games, double(ball_sum) / games,
+									i < ball_count_samples.size() - 1 ? "," : "");
+	}
+	std::cout << "  ]\n}\n";
+	return tr::sys::signal::SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////// SOAK TEST ////////////////////////////////////////////////////////////////
+
+// Saves the replay of a soak test game (marked as exited prematurely if the game isn't over yet).
+static void save_soak_replay(bot_game& game, const std::filesystem::path& directory)
+{
+	if (game.replay.has_value()) {
+		const score_flags flags{!game.game_over(), false};
+		game.replay->set_header({{}, current_timestamp(), game.final_score(), game.final_time(), flags}, "Soak");
+		game.replay->save_to_directory(directory);
+	}
+}
+
+tr::sys::signal run_soak_test(usize minutes, const std::filesystem::path& replay_directory)
+{
+	// The replays would otherwise silently fail to be recorded.
+	try {
+		std::filesystem::create_directories(replay_directory);
+	}
+	catch (std::exception& err) {
+		std::cout << TR_FMT::format("Failed to create replay directory: {}\n", err.what());
+		return tr::sys::signal::FAILURE;
+	}
+
+	std::vector<gamemode> gamemodes{BUILTIN_GAMEMODES.begin(), BUILTIN_GAMEMODES.end()};
+	gamemodes.push_back(stress_gamemode(BUILTIN_GAMEMODES[0]));
+
+	null_event_sink events;
+	std::optional<bot_game> game;
+	usize games{0};
+	// The number of games in which the bot survived until the ball count reached the gamemode's maximum.
+	usize games_at_max_balls{0};
+	bool reached_max_balls{false};
+	std::vector<i64> durations;
+	durations.reserve(SOAK_REPORT_INTERVAL);
+	const usize duration{minutes * 60_s};
+	for (usize time = 1; time <= duration; ++time) {
+		if (!game.has_value() || game->game_over()) {
+			if (game.has_value()) {
+				save_soak_replay(*game, replay_directory);
+			}
+			game.emplace(gamemodes[games % gamemodes.size()], BENCHMARK_SEED + games, bot_settings{}, replay_directory);
+			reached_max_balls = false;
+			++games;
+		}
+
+		const auto start{std::chrono::steady_clock::now()};
+		game->tick(events);
+		durations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		if (!reached_max_balls && game->ball_count() >= game->gamemode().ball.max_count) {
+			reached_max_balls = true;
+			++games_at_max_balls;
+		}
+
+		if (time % SOAK_REPORT_INTERVAL == 0) {
+			const double mean_ns{std::accumulate(durations.begin(), durations.end(), 0.0) / durations.size()};
+			std::ranges::sort(durations);
+			std::cout << TR_FMT::format("{{\"minute\": {}, \"games\": {}, \"games_at_max_balls\": {}, \"mean_ns\": {:.1f}, "
+										"\"p99_ns\": {}, \"max_ns\": {}, \"live_allocations\": {}}}\n",
+										time / SOAK_REPORT_INTERVAL, games, games_at_max_balls, mean_ns,
+										durations[durations.size() * 99 / 100], durations.back(),
+										ALLOCATION_TRACKING ? std::to_string(i64(t_allocations) - i64(t_deallocations)) : "null");
+			durations.clear();
+		}
+	}
+	// The game still running when the time runs out is the longest-running one, so its replay is kept too.
+	if (game.has_value()) {
+		save_soak_replay(*game, replay_directory);
+	}
+	return tr::sys::signal::SUCCESS;
+}
\ No newline at end of file
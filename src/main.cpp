@@ -1,3 +1,4 @@
+#include "../include/headless.hpp"
 #include "../include/input.hpp"
 #include "../include/renderer.hpp"
 #include "../include/settings.hpp"
@@ -5,7 +6,29 @@
 
 tr::sys::signal parse_command_line(std::span<tr::cstring_view> args)
 {
-	return debug_settings::instance().parse(args);
+	const tr::sys::signal signal{debug_settings::instance().parse(args)};
+	if (signal == tr::sys::signal::CONTINUE && !debug_settings::instance().replay_verification_directory().empty()) {
+		return verify_replays(debug_settings::instance().replay_verification_directory());
+	}
+	if (signal == tr::sys::signal::CONTINUE && debug_settings::instance().run_benchmarks()) {
+		return run_benchmarks();
+	}
+	if (signal == tr::sys::signal::CONTINUE && !debug_settings::instance().conformance_reference().empty()) {
+		return run_conformance_check(debug_settings::instance().conformance_reference(),
+									 debug_settings::instance().record_conformance_reference());
+	}
+	if (signal == tr::sys::signal::CONTINUE && debug_settings::instance().run_allocation_check()) {
+		return run_allocation_check();
+	}
+	if (signal == tr::sys::signal::CONTINUE && !debug_settings::instance().batch_simulation_gamemode().empty()) {
+		const debug_settings& settings{debug_settings::instance()};
+		return run_batch_simulation(settings.batch_simulation_gamemode(), settings.batch_simulation_first_seed(),
+									settings.batch_simulation_game_count(), settings.batch_simulation_policy());
+	}
+	if (signal == tr::sys::signal::CONTINUE && debug_settings::instance().soak_test_minutes() != 0) {
+		return run_soak_test(debug_settings::instance().soak_test_minutes(), debug_settings::instance().soak_test_replay_directory());
+	}
+	return signal;
 }
 
 tr::sys::signal initialize()
@@ -24,11 +47,18 @@ tr::sys::signal handle_event(tr::sys::event& event)
 
 tr::sys::signal tick()
 {
-	return current_state::instance().tick();
+	const tr::sys::signal signal{current_state::instance().tick()};
+	audio::instance().dispatch_queued_sounds();
+	return signal;
 }
 
 tr::sys::signal draw()
 {
+	// Frames identical to the last drawn one (as happens when drawing faster than the tick rate) don't need to be drawn again.
+	if (!current_state::instance().redraw_needed()) {
+		return tr::sys::signal::CONTINUE;
+	}
+
 	renderer::instance().start_benchmark();
 	current_state::instance().draw();
 	renderer::instance().draw_cursor(active_settings::instance().primary_hue, input::instance().mouse_pos);
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements mapped_file.hpp.                                                                                                           //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../include/mapped_file.hpp"
+#if __has_include(<sys/mman.h>)
+#define BODGE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/////////////////////////////////////////////////////////////// MAPPED FILE ///////////////////////////////////////////////////////////////
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+	: m_mapped{false}
+{
+#ifdef BODGE_HAS_MMAP
+	const int fd{open(path.c_str(), O_RDONLY)};
+	if (fd == -1) {
+		throw std::runtime_error{TR_FMT::format("Failed to open '{}'.", path.string())};
+	}
+	struct stat stats;
+	if (fstat(fd, &stats) == -1) {
+		close(fd);
+		throw std::runtime_error{TR_FMT::format("Failed to query '{}'.", path.string())};
+	}
+	if (stats.st_size == 0) {
+		close(fd);
+		return;
+	}
+	void* ptr{mmap(nullptr, usize(stats.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+	// The mapping stays valid after the descriptor is closed.
+	close(fd);
+	if (ptr == MAP_FAILED) {
+		throw std::runtime_error{TR_FMT::format("Failed to map '{}'.", path.string())};
+	}
+	m_data = std::span{(const std::byte*)ptr, usize(stats.st_size)};
+	m_mapped = true;
+#else
+	std::ifstream file{tr::open_file_r(path, std::ios::binary)};
+	m_buffer = tr::flush_binary(file);
+	m_data = m_buffer;
+#endif
+}
+
+mapped_file::~mapped_file()
+{
+#ifdef BODGE_HAS_MMAP
+	if (m_mapped) {
+		munmap((void*)m_data.data(), m_data.size());
+	}
+#endif
+}
+
+//
+
+std::span<const std::byte> mapped_file::data() const
+{
+	return m_data;
+}
\ No newline at end of file
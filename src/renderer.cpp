@@ -50,11 +50,13 @@ renderer::window::~window()
 
 //
 
-renderer::window_specific_components::window_specific_components(const settings& settings)
+renderer::window_specific_components::window_specific_components(const settings& settings, ::text_engine& text_engine)
 	: window{settings}
 	, screen{setup_screen()}
 	, circle_renderer{screen.size().x / 1000.0f}
 	, blur_renderer{screen.size().x}
+	, blur_quality{settings.blur_quality}
+	, number_atlas{text_engine, screen.size().x / 1000.0f}
 	, tooltip_manager{basic_renderer}
 {
 	if (debug_settings::instance().show_performance_overlay()) {
@@ -84,7 +86,7 @@ renderer::window_specific_components::~window_specific_components()
 renderer::renderer(const localization& localization, const settings& settings)
 	: text_engine{localization.available_languages.contains(settings.language) ? localization.available_languages.at(settings.language).font
 																			   : std::string{}}
-	, m_window_specific{settings}
+	, m_window_specific{std::in_place, settings, text_engine}
 {
 	set_default_transform(TRANSFORM);
 }
@@ -100,7 +102,7 @@ renderer& renderer::instance()
 void renderer::reopen_window(const settings& settings)
 {
 	close_window();
-	m_window_specific.emplace(settings);
+	m_window_specific.emplace(settings, text_engine);
 }
 
 void renderer::close_window()
@@ -137,12 +139,28 @@ tr::gfx::circle_renderer& renderer::circle()
 	return m_window_specific->circle_renderer;
 }
 
+trail_renderer& renderer::trails()
+{
+	return m_window_specific->trail_renderer;
+}
+
+glyph_atlas& renderer::glyphs()
+{
+	return m_window_specific->glyph_atlas;
+}
+
+const number_atlas& renderer::numbers() const
+{
+	return m_window_specific->number_atlas;
+}
+
 //
 
 void renderer::set_default_transform(const glm::mat4& mat)
 {
 	basic().set_default_transform(mat);
 	circle().set_default_transform(mat);
+	trails().set_transform(mat);
 }
 
 //
@@ -172,13 +190,20 @@ void renderer::add_tooltip(glm::vec2 tl, std::string_view text_string)
 
 //
 
+void renderer::set_blur_quality(blur_quality quality)
+{
+	m_window_specific->blur_quality = quality;
+}
+
 void renderer::draw_blurred(float saturation, float strength)
 {
-	m_window_specific->blur_renderer.draw(screen(), saturation, strength * scale());
+	m_window_specific->blur_renderer.draw(screen(), saturation, strength * scale(), m_window_specific->blur_quality);
 }
 
 void renderer::draw_layers(const tr::gfx::render_target& target)
 {
+	// Ball trails are the bottommost layer, so they're drawn first on their own.
+	trails().draw(target);
 	tr::gfx::draw_layer_range(layer::BALL_TRAILS, layer::FADE_OVERLAY, target, basic(), circle());
 }
 
@@ -23,6 +23,17 @@ constexpr const char* FRAGMENT_SHADER_SRC{
 	"k=vec4(0);W=0.5135/pow(r,0.96);if(a==0){for(d=1/S.x,x=-r,p.x+=x*d;x<=r;x++,p.x+=d){w=W*exp((-x*x)/"
 	"(2*R));k+=texture(t,p)*w;}C=k;}else{for(d=1/S.y,y=-r,p.y+=y*d;y<=r;y++,p.y+=d){w=W*exp((-y*y)/"
 	"(2*R));k+=texture(t,p)*w;}vec3 g=H(k.rgb);C=vec4(G(vec3(g.x,g.y*s,g.z)),1);}}"};
+// Dual filter blur fragment shader source code.
+constexpr const char* DUAL_FILTER_FRAGMENT_SHADER_SRC{
+	"#version 450\n#define L(l) layout(location=l)\nL(0)in vec2 p;L(0)out vec4 C;L(0)uniform sampler2D t;L(1)uniform vec2 h;L(2)uniform "
+	"float s;L(3)uniform int m;vec3 H(vec3 c){vec4 "
+	"K=vec4(0,-1/3.0,2/"
+	"3.0,-1),p=mix(vec4(c.bg,K.wz),vec4(c.gb,K.xy),step(c.b,c.g)),q=mix(vec4(p.xyw,c.r),vec4(c.r,p.yzx),step(p.x,c.r));float "
+	"d=q.x-min(q.w, q.y),e=1.0e-10;return vec3(abs(q.z+(q.w-q.y)/(6*d+e)),d/(q.x+e),q.x);}vec3 G(vec3 c){vec4 K=vec4(1,2/3.0,1/3.0,3);vec3 "
+	"p=abs(fract(c.xxx+K.xyz)*6-K.www);return c.z*mix(K.xxx,clamp(p-K.xxx,0,1),c.y);}void main(){vec2 u=0.5*(vec2(1)+p),v=vec2(h.x,-h.y);vec4 "
+	"k;if(m==0){k=(4*texture(t,u)+texture(t,u-h)+texture(t,u+h)+texture(t,u-v)+texture(t,u+v))/8;}else{k=(texture(t,u-vec2(2*h.x,0))+"
+	"texture(t,u+vec2(2*h.x,0))+texture(t,u-vec2(0,2*h.y))+texture(t,u+vec2(0,2*h.y))+2*(texture(t,u-h)+texture(t,u+h)+texture(t,u-v)+"
+	"texture(t,u+v)))/12;}if(m==2){vec3 g=H(k.rgb);C=vec4(G(vec3(g.x,g.y*s,g.z)),1);}else{C=k;}}"};
 // Blur renderer vertex attributes.
 constexpr std::array<tr::gfx::vertex_binding, 1> BLUR_ATTRIBUTES{{{tr::gfx::NOT_INSTANCED, tr::gfx::vertex_attributes<glm::i8vec2>::list}}};
 // Mesh used by the blur renderer to draw to the screen.
@@ -31,21 +42,48 @@ constexpr std::array<glm::i8vec2, 4> MESH{{{-1, 1}, {1, 1}, {1, -1}, {-1, -1}}};
 // Renderer ID of the blur renderer.
 const u32 BLUR_RENDERER_ID{tr::gfx::alloc_renderer_id()};
 
+// Dual filter shader mode: downsampling into the next level.
+constexpr int DOWNSAMPLE{0};
+// Dual filter shader mode: upsampling into the previous level.
+constexpr int UPSAMPLE{1};
+// Dual filter shader mode: upsampling into the screen and desaturating.
+constexpr int UPSAMPLE_TO_SCREEN{2};
+
+//////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
+
+// Creates the chain of downsampled textures used by the low quality blur.
+static std::array<tr::gfx::render_texture, MAX_BLUR_LEVELS> make_blur_levels(int texture_size)
+{
+	return [&]<usize... Is>(std::index_sequence<Is...>) {
+		return std::array<tr::gfx::render_texture, MAX_BLUR_LEVELS>{tr::gfx::render_texture{glm::ivec2{std::max(texture_size >> (Is + 1), 1)}}...};
+	}(std::make_index_sequence<MAX_BLUR_LEVELS>{});
+}
+
 ////////////////////////////////////////////////////////////// BLUR RENDERER //////////////////////////////////////////////////////////////
 
 blur_renderer::blur_renderer(int texture_size)
 	: m_input_texture{glm::ivec2{texture_size}}
 	, m_auxiliary_texture{glm::ivec2{texture_size}}
+	, m_levels{make_blur_levels(texture_size)}
 	, m_pipeline{tr::gfx::vertex_shader{VERTEX_SHADER_SRC}, tr::gfx::fragment_shader{FRAGMENT_SHADER_SRC}}
+	, m_dual_filter_pipeline{tr::gfx::vertex_shader{VERTEX_SHADER_SRC}, tr::gfx::fragment_shader{DUAL_FILTER_FRAGMENT_SHADER_SRC}}
 	, m_vertex_format{BLUR_ATTRIBUTES}
 	, m_vertex_buffer{MESH}
 {
 	m_pipeline.fragment_shader().set_uniform(1, glm::vec2{m_input_texture.size()});
 	TR_SET_LABEL(m_input_texture, "(Bodge) Blur Renderer Input Texture");
 	TR_SET_LABEL(m_auxiliary_texture, "(Bodge) Blur Renderer Auxilliary Texture");
+	m_input_texture.set_filtering(tr::gfx::min_filter::LINEAR, tr::gfx::mag_filter::LINEAR);
+	for (tr::gfx::render_texture& level : m_levels) {
+		level.set_filtering(tr::gfx::min_filter::LINEAR, tr::gfx::mag_filter::LINEAR);
+		TR_SET_LABEL(level, "(Bodge) Blur Renderer Level Texture");
+	}
 	TR_SET_LABEL(m_pipeline, "(Bodge) Blur Renderer Pipeline");
 	TR_SET_LABEL(m_pipeline.vertex_shader(), "(Bodge) Blur Renderer Vertex Shader");
 	TR_SET_LABEL(m_pipeline.fragment_shader(), "(Bodge) Blur Renderer Fragment Shader");
+	TR_SET_LABEL(m_dual_filter_pipeline, "(Bodge) Blur Renderer Dual Filter Pipeline");
+	TR_SET_LABEL(m_dual_filter_pipeline.vertex_shader(), "(Bodge) Blur Renderer Dual Filter Vertex Shader");
+	TR_SET_LABEL(m_dual_filter_pipeline.fragment_shader(), "(Bodge) Blur Renderer Dual Filter Fragment Shader");
 	TR_SET_LABEL(m_vertex_format, "(Bodge) Blur Renderer Vertex Format");
 	TR_SET_LABEL(m_vertex_buffer, "(Bodge) Blur Renderer Vertex Buffer");
 }
@@ -60,15 +98,29 @@ tr::gfx::render_target blur_renderer::input()
 
 //
 
-void blur_renderer::draw(const tr::gfx::render_target& screen, float saturation, float strength)
+void blur_renderer::draw(const tr::gfx::render_target& screen, float saturation, float strength, blur_quality quality)
 {
-	strength = std::max(std::round(strength), 2.0f);
-
 	tr::gfx::active_renderer = BLUR_RENDERER_ID;
-	tr::gfx::set_shader_pipeline(m_pipeline);
 	tr::gfx::set_vertex_format(m_vertex_format);
 	tr::gfx::set_vertex_buffer(m_vertex_buffer, 0, 0);
 	tr::gfx::set_blend_mode(tr::gfx::PREMUL_ALPHA_BLENDING);
+	switch (quality) {
+	case blur_quality::HIGH:
+		draw_gaussian(screen, saturation, strength);
+		break;
+	case blur_quality::LOW:
+		draw_dual_filter(screen, saturation, strength);
+		break;
+	}
+}
+
+//
+
+void blur_renderer::draw_gaussian(const tr::gfx::render_target& screen, float saturation, float strength)
+{
+	strength = std::max(std::round(strength), 2.0f);
+
+	tr::gfx::set_shader_pipeline(m_pipeline);
 	m_pipeline.fragment_shader().set_uniform(0, m_input_texture);
 	m_pipeline.fragment_shader().set_uniform(2, saturation);
 	m_pipeline.fragment_shader().set_uniform(3, strength);
@@ -80,4 +132,42 @@ void blur_renderer::draw(const tr::gfx::render_target& screen, float saturation,
 	m_pipeline.fragment_shader().set_uniform(4, 1);
 	tr::gfx::set_render_target(screen);
 	tr::gfx::draw(tr::gfx::primitive::TRI_FAN, 0, 4);
+}
+
+void blur_renderer::draw_dual_filter(const tr::gfx::render_target& screen, float saturation, float strength)
+{
+	// A down/up pass pair over n levels spreads the image over roughly 2^(n+1) pixels, so the number of levels is picked from the radius
+	// and the remaining factor is made up for by spreading the sampling offsets.
+	strength = std::max(strength, 2.0f);
+	const usize levels{usize(std::clamp(int(std::log2(strength)) - 1, 1, int(MAX_BLUR_LEVELS)))};
+	const float offset{std::ldexp(strength, -int(levels + 1))};
+
+	tr::gfx::set_shader_pipeline(m_dual_filter_pipeline);
+	auto& shader{m_dual_filter_pipeline.fragment_shader()};
+	shader.set_uniform(2, saturation);
+
+	shader.set_uniform(3, DOWNSAMPLE);
+	for (usize i = 0; i < levels; ++i) {
+		const tr::gfx::render_texture& source{i == 0 ? m_input_texture : m_levels[i - 1]};
+		shader.set_uniform(0, source);
+		shader.set_uniform(1, offset * 0.5f / glm::vec2{source.size()});
+		m_levels[i].clear({});
+		tr::gfx::set_render_target(m_levels[i]);
+		tr::gfx::draw(tr::gfx::primitive::TRI_FAN, 0, 4);
+	}
+
+	shader.set_uniform(3, UPSAMPLE);
+	for (usize i = levels - 1; i > 0; --i) {
+		shader.set_uniform(0, m_levels[i]);
+		shader.set_uniform(1, offset * 0.5f / glm::vec2{m_levels[i].size()});
+		m_levels[i - 1].clear({});
+		tr::gfx::set_render_target(m_levels[i - 1]);
+		tr::gfx::draw(tr::gfx::primitive::TRI_FAN, 0, 4);
+	}
+
+	shader.set_uniform(0, m_levels[0]);
+	shader.set_uniform(1, offset * 0.5f / glm::vec2{m_levels[0].size()});
+	shader.set_uniform(3, UPSAMPLE_TO_SCREEN);
+	tr::gfx::set_render_target(screen);
+	tr::gfx::draw(tr::gfx::primitive::TRI_FAN, 0, 4);
 }
\ No newline at end of file
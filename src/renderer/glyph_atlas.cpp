@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements renderer/glyph_atlas.hpp.                                                                                                  //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/renderer.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Empty space left between glyphs in the atlas so that filtering doesn't bleed neighbouring glyphs into each other.
+constexpr int GLYPH_PADDING{1};
+
+///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
+
+// Packs the properties identifying a rasterized glyph into a key.
+static u64 glyph_key(u32 glyph, font font, tr::sys::ttf_style style, int scaled_size, int scaled_outline)
+{
+	return u64(glyph) | u64(font) << 21 | u64(style) << 24 | u64(scaled_size) << 32 | u64(scaled_outline) << 48;
+}
+
+// Gets the texture coordinates of a rectangle in the atlas.
+static tr::frect2 atlas_uv(const tr::irect2& rect)
+{
+	return {glm::vec2{rect.tl} / float(GLYPH_ATLAS_SIZE), glm::vec2{rect.size} / float(GLYPH_ATLAS_SIZE)};
+}
+
+/////////////////////////////////////////////////////////////// GLYPH ATLAS ///////////////////////////////////////////////////////////////
+
+glyph_atlas::glyph_atlas()
+	: m_texture{glm::ivec2{GLYPH_ATLAS_SIZE}}, m_next_pos{0, 0}, m_row_height{0}, m_generation{0}, m_font_generation{0}
+{
+	m_texture.clear({});
+	m_texture.set_filtering(tr::gfx::min_filter::LINEAR, tr::gfx::mag_filter::LINEAR);
+	TR_SET_LABEL(m_texture, "(Bodge) Glyph Atlas Texture");
+}
+
+//
+
+bool glyph_atlas::valid(const text_layout& layout) const
+{
+	return layout.generation == m_generation;
+}
+
+//
+
+text_layout glyph_atlas::layout(text_engine& text_engine, const text& text, tr::halign align)
+{
+	// Glyphs rasterized with fonts that were since replaced can't be reused.
+	if (m_font_generation != text_engine.font_generation()) {
+		clear();
+		m_font_generation = text_engine.font_generation();
+	}
+
+	const float scale{renderer::instance().scale()};
+	const int scaled_size{int(text.size * scale)};
+	const int scaled_outline{int(text.outline * scale)};
+	const float line_skip{text_engine.line_skip(text.font, text.size) * scale};
+
+	text_layout layout{{}, {0, line_skip + 2 * scaled_outline}, m_generation};
+	const std::vector<std::string_view> lines{text_engine.split_lines(text)};
+	const std::vector<std::vector<int>> glyph_positions{text_engine.glyph_positions(text)};
+	std::vector<std::pair<usize, float>> line_extents;
+	for (usize i = 0; i < lines.size(); ++i) {
+		const glm::vec2 line_tl{0, i * line_skip};
+		const std::vector<int>& positions{glyph_positions[i]};
+		line_extents.emplace_back(layout.glyphs.size(), float(positions.back() + 2 * scaled_outline));
+		usize j{0};
+		for (tr::codepoint chr : tr::utf8::range(lines[i])) {
+			const atlas_glyph rects{find_or_add(text_engine, chr, text, scaled_size, scaled_outline)};
+			const glm::vec2 tl{line_tl + glm::vec2{positions[std::min(j++, positions.size() - 1)], 0}};
+			const tr::frect2 outline_rect{tl, glm::vec2{rects.outline.size}};
+			const tr::frect2 fill_rect{tl + float(scaled_outline), glm::vec2{rects.fill.size}};
+			layout.glyphs.push_back({outline_rect, atlas_uv(rects.outline), fill_rect, atlas_uv(rects.fill)});
+			layout.size.y = std::max(layout.size.y, line_tl.y + rects.outline.size.y);
+		}
+		layout.size.x = std::max(layout.size.x, line_extents.back().second);
+	}
+
+	// If the atlas filled up and was cleared midway, the glyphs laid out before that are gone, so the text has to be laid out again.
+	if (!valid(layout)) {
+		return this->layout(text_engine, text, align);
+	}
+
+	if (align != tr::halign::LEFT) {
+		const float factor{align == tr::halign::CENTER ? 0.5f : 1.0f};
+		for (usize i = 0; i < line_extents.size(); ++i) {
+			const usize end{i + 1 < line_extents.size() ? line_extents[i + 1].first : layout.glyphs.size()};
+			const float offset{(layout.size.x - line_extents[i].second) * factor};
+			for (usize j = line_extents[i].first; j < end; ++j) {
+				layout.glyphs[j].outline_rect.tl.x += offset;
+				layout.glyphs[j].fill_rect.tl.x += offset;
+			}
+		}
+	}
+	return layout;
+}
+
+void glyph_atlas::add_to_renderer(tr::gfx::renderer_2d& renderer, int layer, const text_layout& layout, glm::vec2 tl, float scale,
+								  tr::rgba8 tint) const
+{
+	// All outlines are drawn before any fill so that the outline of a glyph never covers the fill of the glyph before it.
+	for (const laid_out_glyph& glyph : layout.glyphs) {
+		const tr::gfx::simple_textured_mesh_ref quad{renderer.new_textured_fan(layer, 4, m_texture)};
+		tr::fill_rectangle_vertices(quad.positions, {tl + glyph.outline_rect.tl * scale, glyph.outline_rect.size * scale});
+		tr::fill_rectangle_vertices(quad.uvs, glyph.outline_uv);
+		std::ranges::fill(quad.tints, tint);
+	}
+	for (const laid_out_glyph& glyph : layout.glyphs) {
+		const tr::gfx::simple_textured_mesh_ref quad{renderer.new_textured_fan(layer, 4, m_texture)};
+		tr::fill_rectangle_vertices(quad.positions, {tl + glyph.fill_rect.tl * scale, glyph.fill_rect.size * scale});
+		tr::fill_rectangle_vertices(quad.uvs, glyph.fill_uv);
+		std::ranges::fill(quad.tints, tint);
+	}
+}
+
+//
+
+glyph_atlas::atlas_glyph glyph_atlas::find_or_add(text_engine& text_engine, u32 glyph, const text& text, int scaled_size,
+												  int scaled_outline)
+{
+	const u64 key{glyph_key(glyph, text.font, text.style, scaled_size, scaled_outline)};
+	if (const auto it{m_glyphs.find(key)}; it != m_glyphs.end()) {
+		return it->second;
+	}
+
+	const rendered_glyph render{text_engine.render_glyph(glyph, text.font, text.style, text.size, text.outline)};
+	const u32 generation{m_generation};
+	atlas_glyph rects{place(render.outline), place(render.fill)};
+	// If the atlas was cleared while placing the fill, the outline placed before it is gone.
+	if (m_generation != generation) {
+		rects = {place(render.outline), place(render.fill)};
+	}
+	m_glyphs.emplace(key, rects);
+	return rects;
+}
+
+tr::irect2 glyph_atlas::place(const tr::bitmap& bitmap)
+{
+	if (m_next_pos.x + bitmap.size().x > GLYPH_ATLAS_SIZE) {
+		m_next_pos = {0, m_next_pos.y + m_row_height};
+		m_row_height = 0;
+	}
+	if (m_next_pos.y + bitmap.size().y > GLYPH_ATLAS_SIZE) {
+		clear();
+	}
+
+	const tr::irect2 rect{m_next_pos, bitmap.size()};
+	m_texture.set_region(m_next_pos, bitmap);
+	m_next_pos.x += bitmap.size().x + GLYPH_PADDING;
+	m_row_height = std::max(m_row_height, bitmap.size().y + GLYPH_PADDING);
+	return rect;
+}
+
+void glyph_atlas::clear()
+{
+	m_texture.clear({});
+	m_glyphs.clear();
+	m_next_pos = {0, 0};
+	m_row_height = 0;
+	++m_generation;
+}
\ No newline at end of file
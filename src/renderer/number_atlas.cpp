@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements renderer/number_atlas.hpp.                                                                                                 //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/renderer/number_atlas.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// The characters in the atlas.
+constexpr std::string_view NUMBER_ATLAS_CHARACTERS{"0123456789:-"};
+
+///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
+
+// Gets the index of a character in NUMBER_ATLAS_CHARACTERS.
+static usize number_index(char chr)
+{
+	switch (chr) {
+	case ':':
+		return 10;
+	case '-':
+		return 11;
+	default:
+		return usize(chr - '0');
+	}
+}
+
+// Renders the characters of the atlas, storing their sizes in field units.
+static std::unordered_map<char, tr::bitmap> render_numbers(text_engine& text_engine, float scale, number_sizes& sizes)
+{
+	std::unordered_map<char, tr::bitmap> glyphs;
+	for (char chr : NUMBER_ATLAS_CHARACTERS) {
+		tr::bitmap glyph{text_engine.render_gradient_glyph(chr, font::DEFAULT, tr::sys::ttf_style::NORMAL, 64, 5, scale)};
+		sizes[number_index(chr)] = glm::vec2{glyph.size()} / scale;
+		glyphs.emplace(chr, std::move(glyph));
+	}
+	return glyphs;
+}
+
+/////////////////////////////////////////////////////////////// NUMBER ATLAS //////////////////////////////////////////////////////////////
+
+glm::vec2 number_text_size(const number_sizes& sizes, std::string_view text, float scale)
+{
+	glm::vec2 text_size{};
+	for (char chr : text) {
+		const glm::vec2 char_size{sizes[number_index(chr)] * scale};
+		text_size = {text_size.x + char_size.x - 5, std::max<float>(text_size.y, char_size.y)};
+	}
+	return text_size;
+}
+
+//
+
+number_atlas::number_atlas(text_engine& text_engine, float scale)
+	: m_atlas{tr::gfx::build_bitmap_atlas(render_numbers(text_engine, scale, m_sizes))}
+{
+	m_atlas.set_filtering(tr::gfx::min_filter::LINEAR, tr::gfx::mag_filter::LINEAR);
+}
+
+//
+
+const number_sizes& number_atlas::sizes() const
+{
+	return m_sizes;
+}
+
+void number_atlas::add_to_renderer(tr::gfx::renderer_2d& renderer, int layer, std::string_view text, glm::vec2 tl, float scale,
+								   tr::rgba8 tint) const
+{
+	for (char chr : text) {
+		const glm::vec2 size{m_sizes[number_index(chr)] * scale};
+
+		const tr::gfx::simple_textured_mesh_ref character{renderer.new_textured_fan(layer, 4, m_atlas)};
+		tr::fill_rectangle_vertices(character.positions, {tl, size});
+		tr::fill_rectangle_vertices(character.uvs, m_atlas[chr]);
+		std::ranges::fill(character.tints, tint);
+		tl.x += size.x - 5;
+	}
+}
\ No newline at end of file
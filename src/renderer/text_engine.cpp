@@ -6,6 +6,15 @@
 
 #include "../../include/renderer.hpp"
 
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Maximum number of cached font choices.
+constexpr usize FONT_CACHE_CAPACITY{256};
+// Maximum number of cached line skips.
+constexpr usize LINE_SKIP_CACHE_CAPACITY{64};
+// Maximum number of cached text layouts.
+constexpr usize METRICS_CACHE_CAPACITY{512};
+
 ///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
 
 // Loads a font given a filename.
@@ -24,8 +33,27 @@ static tr::sys::ttfont load_font(std::string_view name)
 	throw tr::file_not_found{path.string()};
 }
 
+// Gets the length of a UTF-8 sequence from its leading byte.
+static usize utf8_sequence_length(char lead)
+{
+	const u8 byte{u8(lead)};
+	return byte < 0xC0 ? 1 : byte < 0xE0 ? 2 : byte < 0xF0 ? 3 : 4;
+}
+
 /////////////////////////////////////////////////////////////// TEXT ENGINE ///////////////////////////////////////////////////////////////
 
+usize text_engine::text_key_hash::operator()(const text_key& key) const
+{
+	usize hash{std::hash<std::string_view>{}(key.string)};
+	for (usize field : {usize(key.font), usize(key.style), usize(std::bit_cast<u32>(key.size)), usize(std::bit_cast<u32>(key.outline)),
+						usize(std::bit_cast<u32>(key.max_width)), usize(std::bit_cast<u32>(key.scale))}) {
+		hash ^= field + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+	}
+	return hash;
+}
+
+//
+
 text_engine::optional_font::base& text_engine::optional_font::operator*()
 {
 	return (base&)data;
@@ -70,6 +98,7 @@ tr::sys::ttfont& text_engine::find_font(font font)
 //
 
 text_engine::text_engine(std::string language_font_name)
+	: m_font_cache{FONT_CACHE_CAPACITY}, m_line_skip_cache{LINE_SKIP_CACHE_CAPACITY}, m_metrics_cache{METRICS_CACHE_CAPACITY}
 {
 	m_standard_fonts.emplace(load_font("charge_vector_b.otf"), load_font("linux_biolinum_rb.ttf"));
 	try {
@@ -97,6 +126,7 @@ void text_engine::set_language_font()
 	if (m_language_preview_font.state == optional_font::state::USE_LANGUAGE) {
 		return;
 	}
+	clear_caches();
 
 	if (m_language_font.state == optional_font::state::USE_STORED) {
 		m_language_font->~base();
@@ -112,6 +142,7 @@ void text_engine::set_language_font()
 void text_engine::reload_language_preview_font(std::string font_name)
 {
 	std::lock_guard font_lock{m_mutex};
+	clear_caches();
 
 	const bool had_value{m_language_preview_font.state == optional_font::state::USE_STORED};
 	try {
@@ -157,66 +188,60 @@ text_engine::~text_engine()
 
 font text_engine::determine_font(std::string_view text, font preferred)
 {
+	std::string key{char(preferred)};
+	key.append(text);
+	if (const std::optional<font> cached{m_font_cache.find(key)}; cached.has_value()) {
+		return *cached;
+	}
+
 	std::lock_guard font_lock{m_mutex};
 
 	tr::sys::ttfont& font{find_font(preferred)};
 	if (std::ranges::all_of(tr::utf8::range(text), [&](tr::codepoint chr) { return chr == '\n' || font.contains(chr); })) {
+		m_font_cache.insert(std::move(key), preferred);
 		return preferred;
 	}
 	else {
+		m_font_cache.insert(std::move(key), font::FALLBACK);
 		return font::FALLBACK;
 	}
 }
 
 float text_engine::line_skip(font font, float size)
 {
+	const u64 key{u64(font) << 32 | std::bit_cast<u32>(size * renderer::instance().scale())};
+	if (const std::optional<float> cached{m_line_skip_cache.find(key)}; cached.has_value()) {
+		return *cached;
+	}
+
 	std::lock_guard font_lock{m_mutex};
 
 	tr::sys::ttfont& font_ref{find_font(font)};
 	font_ref.resize(size * renderer::instance().scale());
-	return font_ref.line_skip() / renderer::instance().scale();
+	const float line_skip{font_ref.line_skip() / renderer::instance().scale()};
+	m_line_skip_cache.insert(key, line_skip);
+	return line_skip;
 }
 
 glm::vec2 text_engine::text_size(const text& text)
 {
-	std::lock_guard font_lock{m_mutex};
-
-	const int scaled_outline{int(text.outline * renderer::instance().scale())};
-	float max_width{text.max_width};
-	int outline_max_width{tr::sys::UNLIMITED_WIDTH};
-	if (text.max_width != tr::sys::UNLIMITED_WIDTH) {
-		max_width = (text.max_width - 2 * text.outline) * renderer::instance().scale();
-		outline_max_width = int(max_width + 2 * scaled_outline);
-	}
-
-	tr::sys::ttfont& font_ref{find_font(text.font)};
-	font_ref.resize(text.size * renderer::instance().scale());
-	font_ref.set_style(text.style);
-	font_ref.set_outline(scaled_outline);
-	glm::ivec2 text_size{0, font_ref.text_size(text.string, outline_max_width).y};
-	for (std::string_view line : split_into_lines(text.string, font_ref, outline_max_width)) {
-		text_size.x = std::max(text_size.x, font_ref.measure_text(line, outline_max_width).size);
-	}
-	return glm::vec2{text_size} / renderer::instance().scale();
+	return metrics(text).size;
 }
 
 usize text_engine::count_lines(const text& text)
 {
-	std::lock_guard font_lock{m_mutex};
+	return metrics(text).lines.size();
+}
 
-	const int scaled_outline{int(text.outline * renderer::instance().scale())};
-	float max_width{text.max_width};
-	int outline_max_width{tr::sys::UNLIMITED_WIDTH};
-	if (text.max_width != tr::sys::UNLIMITED_WIDTH) {
-		max_width = (text.max_width - 2 * text.outline) * renderer::instance().scale();
-		outline_max_width = int(max_width + 2 * scaled_outline);
+std::vector<std::string_view> text_engine::split_lines(const text& text)
+{
+	const text_metrics metrics{this->metrics(text)};
+	std::vector<std::string_view> lines;
+	lines.reserve(metrics.lines.size());
+	for (const auto [offset, length] : metrics.lines) {
+		lines.emplace_back(text.string.substr(offset, length));
 	}
-
-	tr::sys::ttfont& font_ref{find_font(text.font)};
-	font_ref.resize(text.size * renderer::instance().scale());
-	font_ref.set_style(text.style);
-	font_ref.set_outline(scaled_outline);
-	return tr::sys::split_into_lines(text.string, font_ref, outline_max_width).size();
+	return lines;
 }
 
 tr::bitmap text_engine::render_text(const text& text, tr::halign align)
@@ -242,15 +267,38 @@ tr::bitmap text_engine::render_text(const text& text, tr::halign align)
 	return render;
 }
 
-tr::bitmap text_engine::render_gradient_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline)
+u32 text_engine::font_generation() const
 {
-	std::lock_guard font_lock{m_mutex};
+	return m_font_generation;
+}
+
+std::vector<std::vector<int>> text_engine::glyph_positions(const text& text)
+{
+	return metrics(text).glyph_positions;
+}
 
-	const int scaled_outline{int(outline * renderer::instance().scale())};
+rendered_glyph text_engine::render_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline)
+{
+	std::lock_guard font_lock{m_mutex};
 
 	tr::sys::ttfont& font_ref{find_font(font)};
 	font_ref.resize(size * renderer::instance().scale());
 	font_ref.set_style(style);
+	font_ref.set_outline(int(outline * renderer::instance().scale()));
+	tr::bitmap outline_render{font_ref.render(glyph, DARK_GRAY)};
+	font_ref.set_outline(0);
+	return {std::move(outline_render), font_ref.render(glyph, WHITE)};
+}
+
+tr::bitmap text_engine::render_gradient_glyph(u32 glyph, font font, tr::sys::ttf_style style, float size, float outline, float scale)
+{
+	std::lock_guard font_lock{m_mutex};
+
+	const int scaled_outline{int(outline * scale)};
+
+	tr::sys::ttfont& font_ref{find_font(font)};
+	font_ref.resize(size * scale);
+	font_ref.set_style(style);
 	font_ref.set_outline(scaled_outline);
 	tr::bitmap render{font_ref.render(glyph, "00000080"_rgba8)};
 	font_ref.set_outline(0);
@@ -262,4 +310,66 @@ tr::bitmap text_engine::render_gradient_glyph(u32 glyph, font font, tr::sys::ttf
 	}
 	render.blit(glm::ivec2{scaled_outline}, fill.sub({{}, render.size() - 2 * scaled_outline}));
 	return render;
+}
+
+//
+
+text_engine::text_metrics text_engine::metrics(const text& text)
+{
+	text_key key{std::string{text.string}, text.font, text.style, text.size, text.outline, text.max_width, renderer::instance().scale()};
+	if (std::optional<text_metrics> cached{m_metrics_cache.find(key)}; cached.has_value()) {
+		return std::move(*cached);
+	}
+
+	std::lock_guard font_lock{m_mutex};
+
+	const int scaled_outline{int(text.outline * renderer::instance().scale())};
+	float max_width{text.max_width};
+	int outline_max_width{tr::sys::UNLIMITED_WIDTH};
+	if (text.max_width != tr::sys::UNLIMITED_WIDTH) {
+		max_width = (text.max_width - 2 * text.outline) * renderer::instance().scale();
+		outline_max_width = int(max_width + 2 * scaled_outline);
+	}
+
+	tr::sys::ttfont& font_ref{find_font(text.font)};
+	font_ref.resize(text.size * renderer::instance().scale());
+	font_ref.set_style(text.style);
+	font_ref.set_outline(scaled_outline);
+	text_metrics metrics{{}, {}, {}};
+	glm::ivec2 text_size{0, font_ref.text_size(text.string, outline_max_width).y};
+	const std::vector<std::string_view> lines{tr::sys::split_into_lines(text.string, font_ref, outline_max_width)};
+	for (std::string_view line : lines) {
+		text_size.x = std::max(text_size.x, font_ref.measure_text(line, outline_max_width).size);
+		metrics.lines.emplace_back(u32(line.data() - text.string.data()), u32(line.size()));
+	}
+	metrics.size = glm::vec2{text_size} / renderer::instance().scale();
+
+	// The advance of a glyph including its kerning with the next one is the width of the pair minus the width of the next glyph alone,
+	// so the pen positions are found in a single pass over every line.
+	font_ref.set_outline(0);
+	for (std::string_view line : lines) {
+		std::vector<int>& positions{metrics.glyph_positions.emplace_back(1, 0)};
+		usize glyph_size{line.empty() ? 0 : std::min(utf8_sequence_length(line[0]), line.size())};
+		for (usize start = 0; start + glyph_size < line.size();) {
+			const usize next_size{std::min(utf8_sequence_length(line[start + glyph_size]), line.size() - start - glyph_size)};
+			const int pair_width{font_ref.measure_text(line.substr(start, glyph_size + next_size), tr::sys::UNLIMITED_WIDTH).size};
+			const int next_width{font_ref.measure_text(line.substr(start + glyph_size, next_size), tr::sys::UNLIMITED_WIDTH).size};
+			positions.push_back(positions.back() + pair_width - next_width);
+			start += glyph_size;
+			glyph_size = next_size;
+		}
+		if (!line.empty()) {
+			positions.push_back(font_ref.measure_text(line, tr::sys::UNLIMITED_WIDTH).size);
+		}
+	}
+	m_metrics_cache.insert(std::move(key), metrics);
+	return metrics;
+}
+
+void text_engine::clear_caches()
+{
+	m_font_cache.clear();
+	m_line_skip_cache.clear();
+	m_metrics_cache.clear();
+	++m_font_generation;
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                                                                       //
+// Implements renderer/trail_renderer.hpp.                                                                                               //
+//                                                                                                                                       //
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "../../include/renderer/trail_renderer.hpp"
+
+//////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
+
+// Trail renderer vertex shader source code.
+constexpr const char* VERTEX_SHADER_SRC{
+	"#version 450\n#define L(l) layout(location=l)\nL(0)in vec2 q;L(1)in vec4 e;L(2)in vec4 s;L(0)uniform mat4 T;out gl_PerVertex{vec4 "
+	"gl_Position;};L(0)out vec2 P;L(1)flat out float l;L(2)flat out vec4 S;void main(){vec2 d=e.zw-e.xy;l=length(d);vec2 "
+	"x=l>0?d/l:vec2(1,0),y=vec2(-x.y,x.x);P=vec2(mix(-s.x,l+s.x,q.x),q.y*s.x);S=s;gl_Position=T*vec4(e.xy+x*P.x+y*P.y,0,1);}"};
+// Trail renderer fragment shader source code.
+constexpr const char* FRAGMENT_SHADER_SRC{
+	"#version 450\n#define L(l) layout(location=l)\nL(0)in vec2 P;L(1)flat in float l;L(2)flat in vec4 S;L(0)out vec4 C;vec3 G(vec3 c){vec4 "
+	"K=vec4(1,2/3.0,1/3.0,3);vec3 p=abs(fract(c.xxx+K.xyz)*6-K.www);return c.z*mix(K.xxx,clamp(p-K.xxx,0,1),c.y);}void main(){float "
+	"t=l>0?clamp(P.x/l,0,1):0,d=length(vec2(P.x-t*l,P.y)),a=clamp((S.x-d)/max(fwidth(d),1e-4)+0.5,0,1);C=vec4(G(vec3(S.w,1,1)),mix(S.y,"
+	"S.z,t)*a);}"};
+// Trail renderer vertex attributes.
+constexpr std::array<tr::gfx::vertex_binding, 3> TRAIL_ATTRIBUTES{{
+	{tr::gfx::NOT_INSTANCED, tr::gfx::vertex_attributes<glm::i8vec2>::list},
+	{1, tr::gfx::vertex_attributes<glm::vec4>::list},
+	{1, tr::gfx::vertex_attributes<glm::vec4>::list},
+}};
+// Quad expanded into every trail segment (X goes along the segment, Y across it).
+constexpr std::array<glm::i8vec2, 4> QUAD{{{0, -1}, {1, -1}, {1, 1}, {0, 1}}};
+
+// Renderer ID of the trail renderer.
+const u32 TRAIL_RENDERER_ID{tr::gfx::alloc_renderer_id()};
+
+///////////////////////////////////////////////////////////// TRAIL RENDERER //////////////////////////////////////////////////////////////
+
+trail_renderer::trail_renderer()
+	: m_pipeline{tr::gfx::vertex_shader{VERTEX_SHADER_SRC}, tr::gfx::fragment_shader{FRAGMENT_SHADER_SRC}}
+	, m_vertex_format{TRAIL_ATTRIBUTES}
+	, m_quad_buffer{QUAD}
+	, m_transform{TRANSFORM}
+{
+	TR_SET_LABEL(m_pipeline, "(Bodge) Trail Renderer Pipeline");
+	TR_SET_LABEL(m_pipeline.vertex_shader(), "(Bodge) Trail Renderer Vertex Shader");
+	TR_SET_LABEL(m_pipeline.fragment_shader(), "(Bodge) Trail Renderer Fragment Shader");
+	TR_SET_LABEL(m_vertex_format, "(Bodge) Trail Renderer Vertex Format");
+	TR_SET_LABEL(m_quad_buffer, "(Bodge) Trail Renderer Quad Buffer");
+	TR_SET_LABEL(m_endpoint_buffer, "(Bodge) Trail Renderer Endpoint Buffer");
+	TR_SET_LABEL(m_parameter_buffer, "(Bodge) Trail Renderer Parameter Buffer");
+}
+
+//
+
+void trail_renderer::set_transform(const glm::mat4& mat)
+{
+	m_transform = mat;
+}
+
+void trail_renderer::add_segment(glm::vec2 a, glm::vec2 b, float radius, float opacity_a, float opacity_b, float hue)
+{
+	m_endpoints.emplace_back(a, b);
+	m_parameters.emplace_back(radius, opacity_a, opacity_b, hue / 360);
+}
+
+//
+
+void trail_renderer::draw(const tr::gfx::render_target& target)
+{
+	if (m_endpoints.empty()) {
+		return;
+	}
+
+	m_endpoint_buffer.set(m_endpoints);
+	m_parameter_buffer.set(m_parameters);
+
+	tr::gfx::active_renderer = TRAIL_RENDERER_ID;
+	tr::gfx::set_render_target(target);
+	tr::gfx::set_shader_pipeline(m_pipeline);
+	tr::gfx::set_vertex_format(m_vertex_format);
+	tr::gfx::set_vertex_buffer(m_quad_buffer, 0, 0);
+	tr::gfx::set_vertex_buffer(m_endpoint_buffer, 1, 0);
+	tr::gfx::set_vertex_buffer(m_parameter_buffer, 2, 0);
+	tr::gfx::set_blend_mode(tr::gfx::MAX_BLENDING);
+	m_pipeline.vertex_shader().set_uniform(0, m_transform);
+	tr::gfx::draw_instances(tr::gfx::primitive::TRI_FAN, 0, 4, m_endpoints.size());
+
+	m_endpoints.clear();
+	m_parameters.clear();
+}
\ No newline at end of file
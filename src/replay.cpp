@@ -8,8 +8,34 @@
 
 //////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
 
+#ifdef BODGE_STRICT_FP
+// Replay file version identifier (strict builds simulate games differently, so their replays can't be played back by other builds).
+constexpr u8 REPLAY_VERSION{4};
+// Replay header index file version identifier (separate from other builds' so that their replays aren't listed).
+constexpr u8 REPLAY_INDEX_VERSION{4};
+#else
 // Replay file version identifier.
-constexpr u8 REPLAY_VERSION{2};
+constexpr u8 REPLAY_VERSION{3};
+// Replay header index file version identifier.
+constexpr u8 REPLAY_INDEX_VERSION{3};
+#endif
+// Name of the replay header index file.
+constexpr const char* REPLAY_INDEX_FILENAME{"index.bin"};
+// Number of inputs stored in one replay chunk.
+constexpr usize REPLAY_CHUNK_SIZE{1024};
+// Upper bound of the size of an encoded chunk of inputs (varints take up at most 5 bytes).
+constexpr usize MAX_ENCODED_CHUNK_SIZE{5 + REPLAY_CHUNK_SIZE * 2 * 5};
+// Number of steps per field unit replay inputs are quantized to.
+constexpr float INPUT_QUANTIZATION_SCALE{64};
+// Maximum size of a replay record (anything larger is treated as corruption).
+constexpr u32 MAX_RECORD_SIZE{1 << 20};
+
+// Replay file record types.
+enum class record_type : u8 {
+	HEADER,      // Replay header.
+	INPUTS,      // Chunk of inputs.
+	STATE_HASHES // Run of game state hashes.
+};
 
 ///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
 
@@ -23,6 +49,289 @@ static std::string to_filename(std::string_view name)
 	return filename.empty() ? "replay" : filename;
 }
 
+// Computes the checksum of a record's contents (32-bit FNV-1a).
+static u32 checksum(std::span<const std::byte> data)
+{
+	u32 hash{0x811C9DC5};
+	for (std::byte byte : data) {
+		hash = (hash ^ u32(byte)) * 0x01000193;
+	}
+	return hash;
+}
+
+// Appends an unsigned integer to a buffer in LEB128 varint form.
+static void write_varint(std::string& out, u32 value)
+{
+	while (value >= 0x80) {
+		out.push_back(char((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(char(value));
+}
+
+// Reads a LEB128 varint from a buffer, returning std::nullopt if it is truncated or malformed.
+static std::optional<u32> read_varint(std::span<const std::byte>& data)
+{
+	u32 value{0};
+	for (int shift = 0; shift < 35 && !data.empty(); shift += 7) {
+		const u8 byte{u8(data.front())};
+		data = data.subspan(1);
+		value |= u32(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return value;
+		}
+	}
+	return std::nullopt;
+}
+
+// Maps a signed integer to an unsigned one such that values close to 0 are small.
+static u32 zigzag(i32 value)
+{
+	return (u32(value) << 1) ^ u32(value >> 31);
+}
+
+// Reverses zigzag().
+static i32 unzigzag(u32 value)
+{
+	return i32(value >> 1) ^ -i32(value & 1);
+}
+
+// Encodes a chunk of inputs as the deltas between their quantized values, replacing the contents of a buffer.
+static void encode_inputs(std::string& data, std::span<const glm::vec2> inputs)
+{
+	data.clear();
+	write_varint(data, u32(inputs.size()));
+	glm::ivec2 prev{0, 0};
+	for (glm::vec2 input : inputs) {
+		const glm::ivec2 quantized{glm::round(input * INPUT_QUANTIZATION_SCALE)};
+		write_varint(data, zigzag(quantized.x - prev.x));
+		write_varint(data, zigzag(quantized.y - prev.y));
+		prev = quantized;
+	}
+}
+
+// Decodes a chunk of inputs encoded with encode_inputs(), returning false if the data is malformed.
+static bool decode_inputs(std::span<const std::byte> data, std::vector<glm::vec2>& out)
+{
+	const std::optional<u32> size{read_varint(data)};
+	if (!size.has_value() || *size > data.size() / 2) {
+		return false;
+	}
+
+	out.reserve(*size);
+	glm::ivec2 prev{0, 0};
+	for (u32 i = 0; i < *size; ++i) {
+		const std::optional<u32> dx{read_varint(data)};
+		const std::optional<u32> dy{read_varint(data)};
+		if (!dx.has_value() || !dy.has_value()) {
+			return false;
+		}
+		prev += glm::ivec2{unzigzag(*dx), unzigzag(*dy)};
+		out.push_back(glm::vec2{prev} / INPUT_QUANTIZATION_SCALE);
+	}
+	return true;
+}
+
+// Encodes a run of state hashes starting at a given index, replacing the contents of a buffer.
+static void encode_state_hashes(std::string& data, usize first, std::span<const u64> hashes)
+{
+	data.clear();
+	write_varint(data, u32(first));
+	write_varint(data, u32(hashes.size()));
+	data.append((const char*)hashes.data(), hashes.size_bytes());
+}
+
+// Decodes a run of state hashes encoded with encode_state_hashes() and appends it, returning false if the data is malformed or the run
+// doesn't directly follow the hashes that were already read.
+static bool decode_state_hashes(std::span<const std::byte> data, std::vector<u64>& out)
+{
+	const std::optional<u32> first{read_varint(data)};
+	const std::optional<u32> size{read_varint(data)};
+	if (!first.has_value() || !size.has_value() || *first != out.size() || data.size() != *size * sizeof(u64)) {
+		return false;
+	}
+
+	out.resize(out.size() + *size);
+	std::memcpy(out.data() + *first, data.data(), data.size());
+	return true;
+}
+
+// Encrypts and writes a record to a replay file using a buffer for the encrypted data.
+static void write_record(std::ostream& os, record_type type, std::string_view data, std::vector<std::byte>& encrypted)
+{
+	tr::encrypt_to(encrypted, data, g_rng.generate<u8>());
+	tr::binary_write(os, u8(type));
+	tr::binary_write(os, u32(encrypted.size()));
+	tr::binary_write(os, checksum(std::as_bytes(std::span{data})));
+	os.write((const char*)encrypted.data(), encrypted.size());
+	os.flush();
+}
+
+// Encrypts and writes a record to a replay file.
+static void write_record(std::ostream& os, record_type type, std::string_view data)
+{
+	std::vector<std::byte> encrypted;
+	write_record(os, type, data, encrypted);
+}
+
+// Reads a record of a replay file, decrypting it if it is of the wanted type and skipping it otherwise.
+// Returns the type of the record, or std::nullopt if the end of the file or a truncated or corrupted record was reached.
+static std::optional<record_type> read_record(std::istream& is, record_type wanted, std::vector<std::byte>& out)
+{
+	try {
+		const record_type type{tr::binary_read<u8>(is)};
+		const u32 size{tr::binary_read<u32>(is)};
+		const u32 expected_checksum{tr::binary_read<u32>(is)};
+		if (!is || size > MAX_RECORD_SIZE) {
+			return std::nullopt;
+		}
+		else if (type != wanted) {
+			is.seekg(size, std::ios::cur);
+			return is.good() ? std::optional{type} : std::nullopt;
+		}
+
+		std::vector<std::byte> encrypted(size);
+		is.read((char*)encrypted.data(), size);
+		if (usize(is.gcount()) != size) {
+			return std::nullopt;
+		}
+		tr::decrypt_to(out, encrypted);
+		return checksum(out) == expected_checksum ? std::optional{type} : std::nullopt;
+	}
+	catch (std::exception&) {
+		return std::nullopt;
+	}
+}
+
+// Reads the header of a replay file, leaving the stream positioned after the version byte.
+static replay_header read_header(std::istream& is)
+{
+	if (tr::binary_read<u8>(is) != REPLAY_VERSION) {
+		throw std::runtime_error{"Unsupported replay version."};
+	}
+	const std::streampos records_start{is.tellg()};
+
+	// The last valid header is the most up-to-date one.
+	std::optional<replay_header> header;
+	std::vector<std::byte> buffer;
+	while (const std::optional<record_type> type{read_record(is, record_type::HEADER, buffer)}) {
+		if (type == record_type::HEADER) {
+			header.emplace(tr::binary_read<replay_header>(buffer));
+		}
+	}
+	if (!header.has_value()) {
+		throw std::runtime_error{"Replay has no valid header."};
+	}
+
+	is.clear();
+	is.seekg(records_start);
+	return *header;
+}
+
+// Reads the state hashes of a replay file, leaving the stream at the position it was at.
+static std::vector<u64> read_state_hashes(std::istream& is)
+{
+	const std::streampos records_start{is.tellg()};
+
+	std::vector<u64> hashes;
+	std::vector<std::byte> buffer;
+	while (const std::optional<record_type> type{read_record(is, record_type::STATE_HASHES, buffer)}) {
+		if (type == record_type::STATE_HASHES && !decode_state_hashes(buffer, hashes)) {
+			break;
+		}
+	}
+
+	is.clear();
+	is.seekg(records_start);
+	return hashes;
+}
+
+////////////////////////////////////////////////////////////// REPLAY INDEX ///////////////////////////////////////////////////////////////
+
+// Cached header of a replay file.
+struct replay_index_entry {
+	// The name of the replay file.
+	std::string filename;
+	// The last modification time of the replay file.
+	i64 mtime;
+	// The size of the replay file.
+	u64 size;
+	// Whether the header could be read (files that can't be loaded are indexed too so that they aren't read again on every listing).
+	bool valid;
+	// The header of the replay (if valid).
+	replay_header header;
+};
+template <> struct tr::binary_reader<replay_index_entry> {
+	static std::span<const std::byte> read_from_span(std::span<const std::byte> span, replay_index_entry& out)
+	{
+		span = tr::binary_read(span, out.filename);
+		span = tr::binary_read(span, out.mtime);
+		span = tr::binary_read(span, out.size);
+		span = tr::binary_read(span, out.valid);
+		return out.valid ? tr::binary_read(span, out.header) : span;
+	}
+};
+template <> struct tr::binary_writer<replay_index_entry> {
+	static void write_to_stream(std::ostream& os, const replay_index_entry& in)
+	{
+		tr::binary_write(os, in.filename);
+		tr::binary_write(os, in.mtime);
+		tr::binary_write(os, in.size);
+		tr::binary_write(os, in.valid);
+		if (in.valid) {
+			tr::binary_write(os, in.header);
+		}
+	}
+};
+
+// Gets the last modification time of a file in a serializable form.
+static i64 mtime(const std::filesystem::directory_entry& file)
+{
+	return i64(file.last_write_time().time_since_epoch().count());
+}
+
+// Loads the replay header index of a directory.
+static std::vector<replay_index_entry> load_replay_index(const std::filesystem::path& directory)
+{
+	try {
+		std::ifstream file{tr::open_file_r(directory / REPLAY_INDEX_FILENAME, std::ios::binary)};
+		if (tr::binary_read<u8>(file) != REPLAY_INDEX_VERSION) {
+			return {};
+		}
+		return tr::binary_read<std::vector<replay_index_entry>>(tr::decrypt(tr::flush_binary(file)));
+	}
+	catch (std::exception&) {
+		return {};
+	}
+}
+
+// Saves the replay header index of a directory.
+static void save_replay_index(const std::filesystem::path& directory, const std::vector<replay_index_entry>& index)
+{
+	try {
+		std::ostringstream buffer;
+		tr::binary_write(buffer, index);
+		const std::vector<std::byte> encrypted{tr::encrypt(tr::range_bytes(buffer.view()), g_rng.generate<u8>())};
+
+		// The index is written to a temporary file first so that a crash midway through can't leave a corrupted index behind.
+		const std::filesystem::path path{directory / REPLAY_INDEX_FILENAME};
+		std::filesystem::path temp_path{path};
+		temp_path += ".tmp";
+		{
+			std::ofstream file{tr::open_file_w(temp_path, std::ios::binary)};
+			tr::binary_write(file, REPLAY_INDEX_VERSION);
+			tr::binary_write(file, std::span{encrypted});
+			if (!file) {
+				throw std::runtime_error{"Failed to write replay index."};
+			}
+		}
+		std::filesystem::rename(temp_path, path);
+	}
+	catch (std::exception&) {
+		return;
+	}
+}
+
 ////////////////////////////////////////////////////////////// REPLAY HEADER //////////////////////////////////////////////////////////////
 
 std::span<const std::byte> tr::binary_reader<replay_header>::read_from_span(std::span<const std::byte> span, replay_header& out)
@@ -45,42 +354,102 @@ void tr::binary_writer<replay_header>::write_to_stream(std::ostream& os, const r
 
 ///////////////////////////////////////////////////////////////// REPLAY //////////////////////////////////////////////////////////////////
 
-replay::replay(std::string_view player, const gamemode& gamemode, u64 seed)
-	: m_header{}
+replay::replay(std::string_view player, const gamemode& gamemode, u64 seed, const std::filesystem::path& directory)
+	: m_header{}, m_next_chunk{0}, m_unsaved{false}, m_next_input{0}, m_position{0}, m_prev_input{}, m_written_state_hashes{0}
 {
+	m_header.timestamp = current_timestamp();
+	m_header.flags.exited_prematurely = true;
+	m_header.name = "Unsaved";
 	m_header.player = player;
 	m_header.gamemode = gamemode;
 	m_header.seed = seed;
+	// Everything written while recording is preallocated so that appending inputs never allocates.
+	m_chunk.reserve(REPLAY_CHUNK_SIZE);
+	m_state_hashes.reserve(REPLAY_CHUNK_SIZE / STATE_HASH_INTERVAL + 1);
+	m_encoded_record.reserve(MAX_ENCODED_CHUNK_SIZE);
+	m_encrypted_record.reserve(MAX_ENCODED_CHUNK_SIZE);
+
+	try {
+		int index{0};
+		do {
+			m_path = directory / TR_FMT::format("unsaved({}).dat", index++);
+		} while (std::filesystem::exists(m_path));
+		m_ofile = tr::open_file_w(m_path, std::ios::binary);
+		m_unsaved = true;
+
+		tr::binary_write(m_ofile, REPLAY_VERSION);
+		std::ostringstream bufstream{std::ios::binary};
+		tr::binary_write(bufstream, m_header);
+		write_record(m_ofile, record_type::HEADER, bufstream.view());
+	}
+	catch (std::exception&) {
+		m_ofile.close();
+		return;
+	}
 }
 
 replay::replay(const std::filesystem::path& path)
+	: m_path{path}
+	, m_ifile{tr::open_file_r(path, std::ios::binary)}
+	, m_next_chunk{0}
+	, m_unsaved{false}
+	, m_next_input{0}
+	, m_position{0}
+	, m_prev_input{}
+	, m_written_state_hashes{0}
 {
-	std::vector<std::byte> encrypted;
-	std::vector<std::byte> decrypted;
-	std::ifstream file{tr::open_file_r(path, std::ios::binary)};
-
-	std::ignore = tr::binary_read<u8>(file);
+	m_header = read_header(m_ifile);
+	m_state_hashes = read_state_hashes(m_ifile);
+	read_chunk();
+}
 
-	tr::binary_read(file, encrypted);
-	tr::decrypt_to(decrypted, encrypted);
-	tr::binary_read(decrypted, m_header);
+replay::replay(const replay& r)
+	: replay{r.m_path}
+{
+}
 
-	tr::binary_read(file, encrypted);
-	tr::decrypt_to(decrypted, encrypted);
-	tr::binary_read(decrypted, m_inputs);
-	m_next_it = m_inputs.begin();
+replay::replay(replay&& r) noexcept
+	: m_header{r.m_header}
+	, m_path{std::move(r.m_path)}
+	, m_ofile{std::move(r.m_ofile)}
+	, m_ifile{std::move(r.m_ifile)}
+	, m_chunk_offsets{std::move(r.m_chunk_offsets)}
+	, m_next_chunk{r.m_next_chunk}
+	, m_unsaved{std::exchange(r.m_unsaved, false)}
+	, m_chunk{std::move(r.m_chunk)}
+	, m_next_input{r.m_next_input}
+	, m_position{r.m_position}
+	, m_prev_input{r.m_prev_input}
+	, m_state_hashes{std::move(r.m_state_hashes)}
+	, m_written_state_hashes{r.m_written_state_hashes}
+	, m_encoded_record{std::move(r.m_encoded_record)}
+	, m_encrypted_record{std::move(r.m_encrypted_record)}
+{
 }
 
-replay::replay(const replay& r)
-	: m_header{r.m_header}, m_inputs{r.m_inputs}, m_next_it{m_inputs.begin()}
+replay::~replay()
 {
+	if (m_unsaved) {
+		m_ofile.close();
+		std::error_code ec;
+		std::filesystem::remove(m_path, ec);
+	}
 }
 
 //
 
 void replay::append(glm::vec2 input)
 {
-	m_inputs.push_back(input);
+	++m_position;
+	m_chunk.push_back(input);
+	if (m_chunk.size() == REPLAY_CHUNK_SIZE) {
+		write_chunk();
+	}
+}
+
+void replay::append_state_hash(u64 hash)
+{
+	m_state_hashes.push_back(hash);
 }
 
 void replay::set_header(const score_entry& header, std::string_view name)
@@ -89,36 +458,34 @@ void replay::set_header(const score_entry& header, std::string_view name)
 	m_header.name = name;
 }
 
-void replay::save_to_directory(const std::filesystem::path& directory) const
+void replay::save_to_directory(const std::filesystem::path& directory)
 {
+	if (!m_unsaved) {
+		return;
+	}
+
 	try {
+		write_chunk();
+		std::ostringstream bufstream{std::ios::binary};
+		tr::binary_write(bufstream, m_header);
+		write_record(m_ofile, record_type::HEADER, bufstream.view());
+		m_ofile.close();
+
 		std::string filename{to_filename(m_header.name)};
 		std::filesystem::path path{directory / TR_FMT::format("{}.dat", filename)};
-		std::ofstream file;
-		if (!std::filesystem::exists(path)) {
-			file = tr::open_file_w(path, std::ios::binary);
-		}
-		else {
-			int index{0};
-			do {
-				path = directory / TR_FMT::format("{}({}).dat", filename, index++);
-			} while (std::filesystem::exists(path));
-			file = tr::open_file_w(path, std::ios::binary);
+		int index{0};
+		while (std::filesystem::exists(path)) {
+			path = directory / TR_FMT::format("{}({}).dat", filename, index++);
 		}
+		std::filesystem::rename(m_path, path);
+		m_path = std::move(path);
+		m_unsaved = false;
 
-		tr::binary_write(file, REPLAY_VERSION);
-
-		std::ostringstream bufstream{std::ios::binary};
-		std::vector<std::byte> buffer;
-
-		tr::binary_write(bufstream, m_header);
-		tr::encrypt_to(buffer, bufstream.view(), g_rng.generate<u8>());
-		tr::binary_write(file, buffer);
-
-		bufstream.str({});
-		tr::binary_write(bufstream, m_inputs);
-		tr::encrypt_to(buffer, bufstream.view(), g_rng.generate<u8>());
-		tr::binary_write(file, buffer);
+		const std::filesystem::directory_entry file{m_path};
+		std::vector<replay_index_entry> index{load_replay_index(directory)};
+		std::erase_if(index, [&](const replay_index_entry& entry) { return entry.filename == m_path.filename().string(); });
+		index.push_back({m_path.filename().string(), mtime(file), file.file_size(), true, m_header});
+		save_replay_index(directory, index);
 	}
 	catch (std::exception&) {
 		return;
@@ -134,21 +501,126 @@ const replay_header& replay::header() const
 
 bool replay::done() const
 {
-	return m_next_it == m_inputs.end();
+	return m_next_input == m_chunk.size();
 }
 
 glm::vec2 replay::next_input()
 {
-	return *m_next_it++;
+	++m_position;
+	m_prev_input = m_chunk[m_next_input++];
+	if (done()) {
+		read_chunk();
+	}
+	return m_prev_input;
 }
 
 glm::vec2 replay::prev_input() const
 {
-	return done() ? *std::prev(m_next_it) : *m_next_it;
+	return done() ? m_prev_input : m_chunk[m_next_input];
+}
+
+usize replay::position() const
+{
+	return m_position;
+}
+
+void replay::seek(usize position)
+{
+	if (m_chunk_offsets.empty()) {
+		return;
+	}
+
+	const usize chunk{std::min(position / REPLAY_CHUNK_SIZE, m_chunk_offsets.size() - 1)};
+	m_ifile.clear();
+	m_ifile.seekg(m_chunk_offsets[chunk]);
+	m_next_chunk = chunk;
+	read_chunk();
+	m_next_input = std::min(position - chunk * REPLAY_CHUNK_SIZE, m_chunk.size());
+	m_position = chunk * REPLAY_CHUNK_SIZE + m_next_input;
+	if (m_next_input != 0) {
+		m_prev_input = m_chunk[m_next_input - 1];
+	}
+	if (done()) {
+		read_chunk();
+	}
+}
+
+std::optional<u64> replay::state_hash(usize position) const
+{
+	if (position == 0 || position % STATE_HASH_INTERVAL != 0 || position / STATE_HASH_INTERVAL > m_state_hashes.size()) {
+		return std::nullopt;
+	}
+	return m_state_hashes[position / STATE_HASH_INTERVAL - 1];
+}
+
+//
+
+void replay::write_chunk()
+{
+	if (!m_ofile.is_open()) {
+		m_chunk.clear();
+		m_state_hashes.clear();
+		return;
+	}
+
+	try {
+		if (!m_chunk.empty()) {
+			encode_inputs(m_encoded_record, m_chunk);
+			write_record(m_ofile, record_type::INPUTS, m_encoded_record, m_encrypted_record);
+		}
+		// Hashes are written after the inputs they follow, so a truncated file never has hashes for inputs it doesn't contain.
+		if (!m_state_hashes.empty()) {
+			encode_state_hashes(m_encoded_record, m_written_state_hashes, m_state_hashes);
+			write_record(m_ofile, record_type::STATE_HASHES, m_encoded_record, m_encrypted_record);
+			m_written_state_hashes += m_state_hashes.size();
+		}
+	}
+	catch (std::exception&) {
+		m_ofile.close();
+	}
+	m_chunk.clear();
+	m_state_hashes.clear();
+}
+
+void replay::read_chunk()
+{
+	m_chunk.clear();
+	m_next_input = 0;
+
+	std::vector<std::byte> buffer;
+	std::streampos offset{m_ifile.tellg()};
+	while (const std::optional<record_type> type{read_record(m_ifile, record_type::INPUTS, buffer)}) {
+		if (type == record_type::INPUTS) {
+			if (!decode_inputs(buffer, m_chunk)) {
+				m_chunk.clear();
+				return;
+			}
+			else if (!m_chunk.empty()) {
+				if (m_next_chunk++ == m_chunk_offsets.size()) {
+					m_chunk_offsets.push_back(offset);
+				}
+				return;
+			}
+		}
+		offset = m_ifile.tellg();
+	}
+}
+
+glm::vec2 quantize_replay_input(glm::vec2 input)
+{
+	return glm::vec2{glm::ivec2{glm::round(input * INPUT_QUANTIZATION_SCALE)}} / INPUT_QUANTIZATION_SCALE;
 }
 
 replay_map load_replay_headers(const std::filesystem::path& directory)
 {
+	// Headers are only read from files that aren't in the index or were modified since they were indexed.
+	std::unordered_map<std::string, replay_index_entry> old_index;
+	for (replay_index_entry& entry : load_replay_index(directory)) {
+		std::string filename{entry.filename};
+		old_index.emplace(std::move(filename), std::move(entry));
+	}
+	std::vector<replay_index_entry> new_index;
+	bool index_changed{false};
 	replay_map replays;
 	try {
 		for (std::filesystem::directory_entry file : std::filesystem::directory_iterator{directory}) {
@@ -156,20 +628,35 @@ replay_map load_replay_headers(const std::filesystem::path& directory)
 				continue;
 			}
 
-			try {
-				std::ifstream is{tr::open_file_r(file, std::ios::binary)};
-				const u8 version{tr::binary_read<u8>(is)};
-				if (version == REPLAY_VERSION) {
-					replays.emplace(file.path(), tr::binary_read<replay_header>(tr::decrypt(tr::binary_read<std::vector<std::byte>>(is))));
+			replay_index_entry entry{file.path().filename().string(), mtime(file), file.file_size(), false, {}};
+			const auto it{old_index.find(entry.filename)};
+			if (it != old_index.end() && it->second.mtime == entry.mtime && it->second.size == entry.size) {
+				entry.valid = it->second.valid;
+				entry.header = std::move(it->second.header);
+			}
+			else {
+				try {
+					std::ifstream is{tr::open_file_r(file, std::ios::binary)};
+					entry.header = read_header(is);
+					entry.valid = true;
+				}
+				catch (std::exception&) {
+					entry.valid = false;
 				}
+				index_changed = true;
 			}
-			catch (std::exception&) {
-				continue;
+			if (entry.valid) {
+				replays.emplace(file.path(), entry.header);
 			}
+			new_index.push_back(std::move(entry));
 		}
 	}
 	catch (std::exception&) {
 		return replays;
 	}
+
+	if (index_changed || new_index.size() != old_index.size()) {
+		save_replay_index(directory, new_index);
+	}
 	return replays;
 }
\ No newline at end of file
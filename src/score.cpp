@@ -6,11 +6,136 @@
 
 #include "../include/score.hpp"
 #include "../include/gamemode.hpp"
+#include <numeric>
 
 //////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
 
 // Savefile version identifier.
-constexpr u8 SAVEFILE_VERSION{2};
+constexpr u8 SAVEFILE_VERSION{3};
+// Version identifier of the old savefile format, which is still loaded (and converted when saved).
+constexpr u8 LEGACY_SAVEFILE_VERSION{2};
+// Maximum size of a score description in bytes.
+constexpr usize MAX_DESCRIPTION_SIZE{255 * 4};
+// The number of journaled score entries after which the journal is compacted into the savefile.
+constexpr usize JOURNAL_COMPACTION_THRESHOLD{64};
+// Key mixed into the checksums of the unencrypted parts of the savefile and its journal so that they can't be edited without it.
+constexpr u64 SAVEFILE_CHECKSUM_KEY{0x53636F7265734B79};
+
+///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
+
+// Score entry as stored in a savefile's entry tables.
+struct stored_score_entry {
+	// The UNIX timestamp of when the game happened.
+	i64 timestamp;
+	// The achieved score.
+	i64 score;
+	// The achieved time.
+	ticks time;
+	// Additional score flags.
+	score_flags flags;
+	// Offset of the entry's description in its category's descriptions.
+	u32 description_offset;
+	// Size of the entry's description in bytes.
+	u32 description_size;
+};
+static_assert(sizeof(stored_score_entry) == 32);
+
+// Reads an entry from an entry table.
+static stored_score_entry read_stored_entry(std::span<const std::byte> table, usize index)
+{
+	// The table isn't necessarily aligned, so the entry is copied out instead of being referenced in place.
+	stored_score_entry entry;
+	std::memcpy(&entry, table.data() + index * sizeof(stored_score_entry), sizeof(stored_score_entry));
+	return entry;
+}
+
+// Gets the path of a savefile's journal.
+static std::filesystem::path journal_path(const std::filesystem::path& path)
+{
+	std::filesystem::path journal{path};
+	journal += ".journal";
+	return journal;
+}
+
+// Computes the keyed checksum of unencrypted savefile data.
+static u64 savefile_checksum(std::initializer_list<std::span<const std::byte>> parts)
+{
+	state_hasher hasher;
+	hasher.add(SAVEFILE_CHECKSUM_KEY);
+	for (std::span<const std::byte> part : parts) {
+		for (std::byte byte : part) {
+			hasher.add(byte);
+		}
+	}
+	return hasher.value();
+}
+
+// Entry of the score category offset table.
+struct category_table_entry {
+	// The gamemode the scores were played on.
+	gamemode gamemode;
+	// Cached best score result.
+	i64 best_score;
+	// Cached best time result.
+	ticks best_time;
+	// Offset of the category's entry table in the savefile's entry table block.
+	u64 offset;
+	// The number of entries in the category.
+	u64 size;
+	// Offset of the category's descriptions in the savefile's description block.
+	u64 descriptions_offset;
+	// Size of the category's descriptions in bytes.
+	u64 descriptions_size;
+	// Keyed checksum of the category's entry table and descriptions.
+	u64 checksum;
+};
+template <> struct tr::binary_reader<category_table_entry> {
+	static std::span<const std::byte> read_from_span(std::span<const std::byte> span, category_table_entry& out)
+	{
+		span = tr::binary_read(span, out.gamemode);
+		span = tr::binary_read(span, out.best_score);
+		span = tr::binary_read(span, out.best_time);
+		span = tr::binary_read(span, out.offset);
+		span = tr::binary_read(span, out.size);
+		span = tr::binary_read(span, out.descriptions_offset);
+		span = tr::binary_read(span, out.descriptions_size);
+		return tr::binary_read(span, out.checksum);
+	}
+};
+template <> struct tr::binary_writer<category_table_entry> {
+	static void write_to_stream(std::ostream& os, const category_table_entry& in)
+	{
+		tr::binary_write(os, in.gamemode);
+		tr::binary_write(os, in.best_score);
+		tr::binary_write(os, in.best_time);
+		tr::binary_write(os, in.offset);
+		tr::binary_write(os, in.size);
+		tr::binary_write(os, in.descriptions_offset);
+		tr::binary_write(os, in.descriptions_size);
+		tr::binary_write(os, in.checksum);
+	}
+};
+
+// Score category in the old savefile format.
+struct legacy_score_category {
+	// The gamemode the scores were played on.
+	gamemode gamemode;
+	// Cached best score result.
+	i64 best_score;
+	// Cached best time result.
+	ticks best_time;
+	// List of score entries.
+	std::vector<score_entry> entries;
+};
+template <> struct tr::binary_reader<legacy_score_category> {
+	static std::span<const std::byte> read_from_span(std::span<const std::byte> span, legacy_score_category& out)
+	{
+		span = tr::binary_read(span, out.gamemode);
+		span = tr::binary_read(span, out.best_score);
+		span = tr::binary_read(span, out.best_time);
+		return tr::binary_read(span, out.entries);
+	}
+};
 
 ////////////////////////////////////////////////////////////////// SCORE //////////////////////////////////////////////////////////////////
 
@@ -32,32 +157,107 @@ void tr::binary_writer<score_entry>::write_to_stream(std::ostream& os, const sco
 	tr::binary_write(os, in.flags);
 }
 
-bool compare_scores(const score_entry& l, const score_entry& r)
+///////////////////////////////////////////////////////////// SCORE CATEGORY //////////////////////////////////////////////////////////////
+
+score_category::score_category(const ::gamemode& gamemode)
+	: gamemode{gamemode}, m_best_results{0, 0}
 {
-	return l.score > r.score;
 }
 
-bool compare_times(const score_entry& l, const score_entry& r)
+score_category::score_category(const ::gamemode& gamemode, ::best_results best_results, std::shared_ptr<const mapped_file> file,
+							   std::span<const std::byte> entry_table, std::span<const std::byte> descriptions, u64 checksum)
+	: gamemode{gamemode}
+	, m_best_results{best_results}
+	, m_file{std::move(file)}
+	, m_entry_table{entry_table}
+	, m_descriptions{descriptions}
+	, m_checksum{checksum}
+	, m_check{std::make_shared<integrity_check>()}
 {
-	return l.time > r.time;
 }
 
-///////////////////////////////////////////////////////////// SCORE CATEGORY //////////////////////////////////////////////////////////////
+//
+
+best_results score_category::best_results() const
+{
+	return m_best_results;
+}
+
+usize score_category::size() const
+{
+	return stored_entries().size() / sizeof(stored_score_entry) + m_added_entries.size();
+}
 
-std::span<const std::byte> tr::binary_reader<score_category>::read_from_span(std::span<const std::byte> span, score_category& out)
+score_entry score_category::operator[](usize index) const
 {
-	span = tr::binary_read(span, out.gamemode);
-	span = tr::binary_read(span, out.best_score);
-	span = tr::binary_read(span, out.best_time);
-	return tr::binary_read(span, out.entries);
+	const std::span<const std::byte> entry_table{stored_entries()};
+	const usize stored{entry_table.size() / sizeof(stored_score_entry)};
+	if (index >= stored) {
+		return m_added_entries[index - stored];
+	}
+
+	const stored_score_entry entry{read_stored_entry(entry_table, index)};
+	score_entry out{{}, entry.timestamp, entry.score, entry.time, entry.flags};
+	if (u64(entry.description_offset) + entry.description_size <= m_descriptions.size()) {
+		const usize size{std::min(usize(entry.description_size), MAX_DESCRIPTION_SIZE)};
+		out.description = std::string_view{(const char*)m_descriptions.data() + entry.description_offset, size};
+	}
+	return out;
 }
 
-void tr::binary_writer<score_category>::write_to_stream(std::ostream& os, const score_category& in)
+std::vector<usize> score_category::ranked_by_score() const
 {
-	tr::binary_write(os, in.gamemode);
-	tr::binary_write(os, in.best_score);
-	tr::binary_write(os, in.best_time);
-	tr::binary_write(os, in.entries);
+	std::vector<usize> indices(size());
+	std::iota(indices.begin(), indices.end(), 0_uz);
+	std::ranges::stable_sort(indices, std::greater{}, [this](usize index) { return results(index).score; });
+	return indices;
+}
+
+std::vector<usize> score_category::ranked_by_time() const
+{
+	std::vector<usize> indices(size());
+	std::iota(indices.begin(), indices.end(), 0_uz);
+	std::ranges::stable_sort(indices, std::greater{}, [this](usize index) { return results(index).time; });
+	return indices;
+}
+
+//
+
+void score_category::add(const score_entry& entry)
+{
+	if (size() == 0) {
+		m_best_results = {entry.score, entry.time};
+	}
+	else {
+		m_best_results = {std::max(m_best_results.score, entry.score), std::max(m_best_results.time, entry.time)};
+	}
+	m_added_entries.push_back(entry);
+}
+
+//
+
+best_results score_category::results(usize index) const
+{
+	const std::span<const std::byte> entry_table{stored_entries()};
+	const usize stored{entry_table.size() / sizeof(stored_score_entry)};
+	if (index >= stored) {
+		return {m_added_entries[index - stored].score, m_added_entries[index - stored].time};
+	}
+
+	const stored_score_entry entry{read_stored_entry(entry_table, index)};
+	return {entry.score, entry.time};
+}
+
+std::span<const std::byte> score_category::stored_entries() const
+{
+	if (m_check == nullptr) {
+		return m_entry_table;
+	}
+
+	// The stored entries aren't encrypted, so they are checked against the keyed checksum from the encrypted metadata the first time
+	// they are accessed. Tampered entries are dropped (and left out of the savefile the next time it is written).
+	std::call_once(m_check->flag, [this] { m_check->valid = savefile_checksum({m_entry_table, m_descriptions}) == m_checksum; });
+	return m_check->valid ? m_entry_table : std::span<const std::byte>{};
 }
 
 ///////////////////////////////////////////////////////////////// SAVEFILE ////////////////////////////////////////////////////////////////
@@ -65,16 +265,18 @@ void tr::binary_writer<score_category>::write_to_stream(std::ostream& os, const
 savefile::savefile(const std::filesystem::path& path)
 {
 	try {
-		std::ifstream file{tr::open_file_r(path, std::ios::binary)};
-		const u8 version{tr::binary_read<u8>(file)};
+		std::shared_ptr<const mapped_file> file{std::make_shared<const mapped_file>(path)};
+		std::span<const std::byte> data{file->data()};
+		u8 version;
+		data = tr::binary_read(data, version);
 		if (version == SAVEFILE_VERSION) {
-			const std::vector<std::byte> raw{tr::decrypt(tr::flush_binary(file))};
-			std::span<const std::byte> data{raw};
-			data = tr::binary_read(data, m_name);
-			data = tr::binary_read(data, m_score_categories);
-			data = tr::binary_read(data, m_playtime);
-			data = tr::binary_read(data, gamemode_draft);
-			data = tr::binary_read(data, last_selected_gamemode);
+			load(std::move(file), data);
+			load_journal(path);
+		}
+		else if (version == LEGACY_SAVEFILE_VERSION) {
+			load_legacy(data);
+			// Forces the savefile to be converted the next time a score is added.
+			m_journal_size = JOURNAL_COMPACTION_THRESHOLD;
 		}
 	}
 	catch (std::exception&) {
@@ -84,7 +286,7 @@ savefile::savefile(const std::filesystem::path& path)
 
 //
 
-void savefile::save_to_file(const std::filesystem::path& path)
+void savefile::save_to_file(const std::filesystem::path& path) const
 {
 	// Don't save unnamed savefile.
 	if (unnamed()) {
@@ -92,16 +294,94 @@ void savefile::save_to_file(const std::filesystem::path& path)
 	}
 
 	try {
-		std::ofstream file{tr::open_file_w(path, std::ios::binary)};
+		// Entries are written into fixed-size tables, with their descriptions appended to a separate block.
+		std::vector<category_table_entry> category_table;
+		std::string entry_tables;
+		std::string descriptions;
+		for (const score_category& category : m_score_categories) {
+			const usize table_offset{entry_tables.size()};
+			const usize descriptions_offset{descriptions.size()};
+			for (usize i = 0; i < category.size(); ++i) {
+				const score_entry entry{category[i]};
+				// The entry is zeroed first so that no uninitialized padding bits end up in the file.
+				stored_score_entry stored;
+				std::memset(&stored, 0, sizeof(stored));
+				stored.timestamp = entry.timestamp;
+				stored.score = entry.score;
+				stored.time = entry.time;
+				stored.flags = entry.flags;
+				stored.description_offset = u32(descriptions.size() - descriptions_offset);
+				stored.description_size = u32(entry.description.size());
+				entry_tables.append((const char*)&stored, sizeof(stored));
+				descriptions.append(entry.description);
+			}
+			// Every category is checksummed separately so that only the categories that are actually accessed have to be verified.
+			const u64 checksum{savefile_checksum({tr::range_bytes(std::string_view{entry_tables}.substr(table_offset)),
+												  tr::range_bytes(std::string_view{descriptions}.substr(descriptions_offset))})};
+			category_table.push_back({category.gamemode, category.best_results().score, category.best_results().time, table_offset,
+									  category.size(), descriptions_offset, descriptions.size() - descriptions_offset, checksum});
+		}
+
 		std::ostringstream buffer;
 		tr::binary_write(buffer, m_name);
-		tr::binary_write(buffer, m_score_categories);
 		tr::binary_write(buffer, m_playtime);
 		tr::binary_write(buffer, gamemode_draft);
 		tr::binary_write(buffer, last_selected_gamemode);
+		tr::binary_write(buffer, category_table);
+		tr::binary_write(buffer, u64(entry_tables.size()));
+		tr::binary_write(buffer, u64(descriptions.size()));
+		tr::binary_write(buffer, m_journal_id);
 		const std::vector<std::byte> encrypted{tr::encrypt(tr::range_bytes(buffer.view()), g_rng.generate<u8>())};
-		tr::binary_write(file, SAVEFILE_VERSION);
-		tr::binary_write(file, std::span{encrypted});
+
+		// The old file may still be mapped by other savefile objects, so it is replaced rather than overwritten.
+		std::filesystem::path temp_path{path};
+		temp_path += ".tmp";
+		{
+			std::ofstream file{tr::open_file_w(temp_path, std::ios::binary)};
+			tr::binary_write(file, SAVEFILE_VERSION);
+			tr::binary_write(file, u32(encrypted.size()));
+			tr::binary_write(file, std::span{encrypted});
+			file.write(entry_tables.data(), entry_tables.size());
+			file.write(descriptions.data(), descriptions.size());
+			if (!file) {
+				throw std::runtime_error{"Failed to write savefile."};
+			}
+		}
+		std::filesystem::rename(temp_path, path);
+		// The old journal no longer matches the savefile's journal identifier even if this fails, so it would just be ignored.
+		std::filesystem::remove(journal_path(path));
+	}
+	catch (std::exception&) {
+		return;
+	}
+}
+
+void savefile::append_to_journal(const gamemode& gm, const score_entry& s, const std::filesystem::path& path) const
+{
+	// Don't save unnamed savefile.
+	if (unnamed()) {
+		return;
+	}
+
+	try {
+		std::ostringstream buffer;
+		tr::binary_write(buffer, gm);
+		tr::binary_write(buffer, s);
+		const std::span<const std::byte> record{tr::range_bytes(buffer.view())};
+
+		// The first entry of a journal replaces whatever was left over from an older one.
+		const bool first_entry{m_journal_size == 1};
+		std::ofstream file{tr::open_file_w(journal_path(path), std::ios::binary | (first_entry ? std::ios::trunc : std::ios::app))};
+		if (first_entry) {
+			tr::binary_write(file, m_journal_id);
+		}
+		tr::binary_write(file, u32(record.size()));
+		tr::binary_write(file, savefile_checksum({record}));
+		tr::binary_write(file, record);
+		file.flush();
+		if (!file) {
+			throw std::runtime_error{"Failed to write savefile journal."};
+		}
 	}
 	catch (std::exception&) {
 		return;
@@ -135,7 +415,7 @@ const std::vector<score_category>& savefile::score_categories() const
 best_results savefile::best_results(const gamemode& gm) const
 {
 	std::vector<score_category>::const_iterator category_it{std::ranges::find(m_score_categories, gm, &score_category::gamemode)};
-	return category_it != m_score_categories.end() ? ::best_results{category_it->best_score, category_it->best_time} : ::best_results{0, 0};
+	return category_it != m_score_categories.end() ? category_it->best_results() : ::best_results{0, 0};
 }
 
 void savefile::add_score(const gamemode& gm, const score_entry& s)
@@ -143,14 +423,11 @@ void savefile::add_score(const gamemode& gm, const score_entry& s)
 	std::vector<score_category>::iterator category_it{
 		std::ranges::find_if(m_score_categories, [&](const auto& c) { return c.gamemode == gm; })};
 	if (category_it == m_score_categories.end()) {
-		category_it = m_score_categories.insert(category_it, {gm, s.score, s.time, {}});
+		category_it = m_score_categories.insert(category_it, score_category{gm});
 	}
-	else {
-		category_it->best_score = std::max(category_it->best_score, s.score);
-		category_it->best_time = std::max(category_it->best_time, s.time);
-	}
-	category_it->entries.emplace_back(s);
+	category_it->add(s);
 	m_playtime += s.time;
+	++m_journal_size;
 }
 
 //
@@ -158,4 +435,178 @@ void savefile::add_score(const gamemode& gm, const score_entry& s)
 std::string savefile::format_info(const localization& localization) const
 {
 	return TR_FMT::format("{} {}: {}", localization["total_playtime"], m_name, format_playtime(m_playtime));
+}
+
+//
+
+void savefile::load(std::shared_ptr<const mapped_file> file, std::span<const std::byte> data)
+{
+	u32 metadata_size;
+	data = tr::binary_read(data, metadata_size);
+	if (metadata_size > data.size()) {
+		throw std::runtime_error{"Truncated savefile."};
+	}
+	std::vector<std::byte> metadata;
+	tr::decrypt_to(metadata, data.first(metadata_size));
+	data = data.subspan(metadata_size);
+
+	std::vector<category_table_entry> category_table;
+	u64 entry_tables_size;
+	u64 descriptions_size;
+	std::span<const std::byte> span{metadata};
+	span = tr::binary_read(span, m_name);
+	span = tr::binary_read(span, m_playtime);
+	span = tr::binary_read(span, gamemode_draft);
+	span = tr::binary_read(span, last_selected_gamemode);
+	span = tr::binary_read(span, category_table);
+	span = tr::binary_read(span, entry_tables_size);
+	span = tr::binary_read(span, descriptions_size);
+	span = tr::binary_read(span, m_journal_id);
+	if (entry_tables_size > data.size() || descriptions_size > data.size() - entry_tables_size) {
+		throw std::runtime_error{"Truncated savefile."};
+	}
+
+	const std::span<const std::byte> entry_tables{data.first(entry_tables_size)};
+	const std::span<const std::byte> descriptions{data.subspan(entry_tables_size, descriptions_size)};
+	for (const category_table_entry& entry : category_table) {
+		if (entry.offset > entry_tables.size() || entry.size > (entry_tables.size() - entry.offset) / sizeof(stored_score_entry) ||
+			entry.descriptions_offset > descriptions.size() || entry.descriptions_size > descriptions.size() - entry.descriptions_offset) {
+			throw std::runtime_error{"Corrupted savefile score category."};
+		}
+		m_score_categories.emplace_back(entry.gamemode, ::best_results{entry.best_score, entry.best_time}, file,
+										entry_tables.subspan(entry.offset, entry.size * sizeof(stored_score_entry)),
+										descriptions.subspan(entry.descriptions_offset, entry.descriptions_size), entry.checksum);
+	}
+}
+
+void savefile::load_legacy(std::span<const std::byte> data)
+{
+	std::vector<std::byte> raw;
+	tr::decrypt_to(raw, data);
+	std::vector<legacy_score_category> categories;
+	std::span<const std::byte> span{raw};
+	span = tr::binary_read(span, m_name);
+	span = tr::binary_read(span, categories);
+	span = tr::binary_read(span, m_playtime);
+	span = tr::binary_read(span, gamemode_draft);
+	span = tr::binary_read(span, last_selected_gamemode);
+
+	for (legacy_score_category& legacy : categories) {
+		score_category& category{m_score_categories.emplace_back(legacy.gamemode)};
+		for (const score_entry& entry : legacy.entries) {
+			category.add(entry);
+		}
+	}
+}
+
+void savefile::load_journal(const std::filesystem::path& path)
+{
+	std::vector<std::byte> journal;
+	try {
+		std::ifstream file{tr::open_file_r(journal_path(path), std::ios::binary)};
+		journal = tr::flush_binary(file);
+	}
+	catch (std::exception&) {
+		return;
+	}
+
+	std::span<const std::byte> data{journal};
+	try {
+		u64 id;
+		data = tr::binary_read(data, id);
+		// A journal left over from an interrupted compaction belongs to an older savefile.
+		if (id != m_journal_id) {
+			return;
+		}
+
+		while (!data.empty()) {
+			u32 size;
+			u64 checksum;
+			data = tr::binary_read(data, size);
+			data = tr::binary_read(data, checksum);
+			if (size > data.size() || savefile_checksum({data.first(size)}) != checksum) {
+				throw std::runtime_error{"Torn savefile journal record."};
+			}
+			gamemode gm;
+			score_entry entry;
+			std::span<const std::byte> record{data.first(size)};
+			record = tr::binary_read(record, gm);
+			record = tr::binary_read(record, entry);
+			add_score(gm, entry);
+			data = data.subspan(size);
+		}
+	}
+	catch (std::exception&) {
+		// Everything up to a damaged record is kept, and the journal is compacted the next time a score is added to get rid of it.
+		m_journal_size = JOURNAL_COMPACTION_THRESHOLD;
+	}
+}
+
+void savefile::start_new_journal()
+{
+	m_journal_id = g_rng.generate<u64>();
+	m_journal_size = 0;
+}
+
+//////////////////////////////////////////////////////////// SAVEFILE SERVICE /////////////////////////////////////////////////////////////
+
+savefile_service::savefile_service(const std::filesystem::path& path)
+	: m_path{path}, m_current{std::make_shared<const savefile>(path)}
+{
+}
+
+savefile_service::~savefile_service()
+{
+	if (m_pending_write.valid()) {
+		m_pending_write.wait();
+	}
+}
+
+//
+
+savefile_snapshot savefile_service::snapshot() const
+{
+	std::lock_guard lock{m_mutex};
+	return m_current;
+}
+
+savefile_snapshot savefile_service::modify(const std::function<void(savefile&)>& modification)
+{
+	std::lock_guard lock{m_mutex};
+	// Existing snapshots are never modified; copying is cheap as the stored score entries stay in the shared mapping.
+	std::shared_ptr<savefile> modified{std::make_shared<savefile>(*m_current)};
+	modification(*modified);
+	modified->start_new_journal();
+	queue_write([modified, path = m_path] { modified->save_to_file(path); });
+	m_current = modified;
+	return m_current;
+}
+
+savefile_snapshot savefile_service::add_score(const gamemode& gm, const score_entry& s)
+{
+	std::lock_guard lock{m_mutex};
+	std::shared_ptr<savefile> modified{std::make_shared<savefile>(*m_current)};
+	modified->add_score(gm, s);
+	// The whole savefile is only rewritten once the journal grows large enough, otherwise only the new entry is appended to the journal.
+	if (modified->m_journal_size >= JOURNAL_COMPACTION_THRESHOLD) {
+		modified->start_new_journal();
+		queue_write([modified, path = m_path] { modified->save_to_file(path); });
+	}
+	else {
+		queue_write([modified, gm, s, path = m_path] { modified->append_to_journal(gm, s, path); });
+	}
+	m_current = modified;
+	return m_current;
+}
+
+//
+
+void savefile_service::queue_write(std::function<void()> write)
+{
+	m_pending_write = std::async(std::launch::async, [previous = std::move(m_pending_write), write = std::move(write)] {
+		if (previous.valid()) {
+			previous.wait();
+		}
+		write();
+	});
 }
\ No newline at end of file
@@ -9,7 +9,7 @@
 //////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
 
 // Settings file version identifier.
-constexpr u8 SETTINGS_VERSION{3};
+constexpr u8 SETTINGS_VERSION{4};
 
 ////////////////////////////////////////////////////////////// DEBUG SETTINGS /////////////////////////////////////////////////////////////
 
@@ -43,6 +43,38 @@ tr::sys::signal debug_settings::parse(std::span<tr::cstring_view> args)
 		else if (*arg_it == "--showperf") {
 			m_show_perf = true;
 		}
+		else if (*arg_it == "--verify-replays" && ++arg_it < args.end()) {
+			m_replay_verification_directory = std::filesystem::path{*arg_it};
+		}
+		else if (*arg_it == "--benchmark") {
+			m_run_benchmarks = true;
+		}
+		else if (*arg_it == "--conformance" && ++arg_it < args.end()) {
+			m_conformance_reference = std::filesystem::path{*arg_it};
+		}
+		else if (*arg_it == "--record") {
+			m_record_conformance_reference = true;
+		}
+		else if (*arg_it == "--check-allocations") {
+			m_run_allocation_check = true;
+		}
+		else if (*arg_it == "--simulate" && ++arg_it < args.end()) {
+			m_batch_simulation_gamemode = std::filesystem::path{*arg_it};
+		}
+		else if (*arg_it == "--seeds" && arg_it + 2 < args.end()) {
+			++arg_it;
+			std::from_chars(*arg_it, *arg_it + std::strlen(*arg_it), m_batch_simulation_first_seed);
+			++arg_it;
+			std::from_chars(*arg_it, *arg_it + std::strlen(*arg_it), m_batch_simulation_game_count);
+		}
+		else if (*arg_it == "--policy" && ++arg_it < args.end()) {
+			m_batch_simulation_policy = *arg_it;
+		}
+		else if (*arg_it == "--soak" && arg_it + 2 < args.end()) {
+			++arg_it;
+			std::from_chars(*arg_it, *arg_it + std::strlen(*arg_it), m_soak_test_minutes);
+			m_soak_test_replay_directory = std::filesystem::path{*++arg_it};
+		}
 		else if (*arg_it == "--help") {
 			std::cout << "Bodge " VERSION_STRING " by TRDario, 2025-2026.\n"
 						 "Supported arguments:\n"
@@ -50,7 +82,17 @@ tr::sys::signal debug_settings::parse(std::span<tr::cstring_view> args)
 						 "--userdir <path>       - Overrides the user directory.\n"
 						 "--refreshrate <number> - Overrides the refresh rate.\n"
 						 "--gamespeed <factor>   - Overrides the speed multiplier.\n"
-						 "--showperf             - Shows performance information.\n";
+						 "--showperf             - Shows performance information.\n"
+						 "--verify-replays <dir> - Re-simulates all replays in a directory and exits.\n"
+						 "--benchmark            - Benchmarks the game simulation, prints the results as JSON and exits.\n"
+						 "--conformance <file>   - Checks hashes of the simulation state against a reference file and exits.\n"
+						 "--record               - Makes the conformance check record the reference file instead.\n"
+						 "--check-allocations    - Checks that the game simulation doesn't allocate memory while ticking and exits.\n"
+						 "--simulate <gmd>       - Simulates many games of a gamemode file or built-in gamemode (e.g. gm_classic), prints\n"
+						 "                         statistics as JSON and exits.\n"
+						 "--seeds <first> <n>    - Sets the seeds of the simulated games (default: 0 1000).\n"
+						 "--policy <name>        - Sets the input policy of the simulated games (scripted or bot, default: scripted).\n"
+						 "--soak <min> <dir>     - Plays bot games for a number of minutes, saving their replays to a directory.\n";
 			return tr::sys::signal::SUCCESS;
 		}
 	}
@@ -109,6 +151,61 @@ bool debug_settings::show_performance_overlay() const
 	return m_show_perf;
 }
 
+const std::filesystem::path& debug_settings::replay_verification_directory() const
+{
+	return m_replay_verification_directory;
+}
+
+bool debug_settings::run_benchmarks() const
+{
+	return m_run_benchmarks;
+}
+
+const std::filesystem::path& debug_settings::conformance_reference() const
+{
+	return m_conformance_reference;
+}
+
+bool debug_settings::record_conformance_reference() const
+{
+	return m_record_conformance_reference;
+}
+
+bool debug_settings::run_allocation_check() const
+{
+	return m_run_allocation_check;
+}
+
+const std::filesystem::path& debug_settings::batch_simulation_gamemode() const
+{
+	return m_batch_simulation_gamemode;
+}
+
+u64 debug_settings::batch_simulation_first_seed() const
+{
+	return m_batch_simulation_first_seed;
+}
+
+usize debug_settings::batch_simulation_game_count() const
+{
+	return m_batch_simulation_game_count;
+}
+
+const std::string& debug_settings::batch_simulation_policy() const
+{
+	return m_batch_simulation_policy;
+}
+
+usize debug_settings::soak_test_minutes() const
+{
+	return m_soak_test_minutes;
+}
+
+const std::filesystem::path& debug_settings::soak_test_replay_directory() const
+{
+	return m_soak_test_replay_directory;
+}
+
 //////////////////////////////////////////////////////////////// SETTINGS /////////////////////////////////////////////////////////////////
 
 template <> struct tr::binary_reader<settings> {
@@ -117,6 +214,7 @@ template <> struct tr::binary_reader<settings> {
 		span = tr::binary_read(span, out.window_size);
 		span = tr::binary_read(span, out.display_mode);
 		span = tr::binary_read(span, out.vsync);
+		span = tr::binary_read(span, out.blur_quality);
 		span = tr::binary_read(span, out.mouse_sensitivity);
 		span = tr::binary_read(span, out.player_skin);
 		span = tr::binary_read(span, out.primary_hue);
@@ -133,6 +231,7 @@ template <> struct tr::binary_writer<settings> {
 		tr::binary_write(os, in.window_size);
 		tr::binary_write(os, in.display_mode);
 		tr::binary_write(os, in.vsync);
+		tr::binary_write(os, in.blur_quality);
 		tr::binary_write(os, in.mouse_sensitivity);
 		tr::binary_write(os, in.player_skin);
 		tr::binary_write(os, in.primary_hue);
@@ -30,6 +30,7 @@ state* current_state::operator->()
 
 tr::sys::signal current_state::handle_event(const tr::sys::event& event)
 {
+	m_redraw_needed = true;
 	if (event.is<tr::sys::quit_event>()) {
 		clear();
 		return tr::sys::signal::SUCCESS;
@@ -42,6 +43,20 @@ tr::sys::signal current_state::handle_event(const tr::sys::event& event)
 
 tr::sys::signal current_state::tick()
 {
+	m_redraw_needed = true;
 	state_machine::tick();
 	return empty() ? tr::sys::signal::SUCCESS : tr::sys::signal::CONTINUE;
+}
+
+//
+
+bool current_state::redraw_needed()
+{
+	return m_redraw_needed || (*this)->interpolates_frames();
+}
+
+void current_state::draw()
+{
+	state_machine::draw();
+	m_redraw_needed = false;
 }
\ No newline at end of file
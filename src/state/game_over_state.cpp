@@ -47,7 +47,8 @@ constexpr float TITLE_Y{500.0f - (BUTTONS.size() + 3) * 30};
 // clang-format on
 ///////////////////////////////////////////////////////////// GAME OVER STATE /////////////////////////////////////////////////////////////
 
-game_over_state::game_over_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, blur_in blur_in)
+game_over_state::game_over_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
+								 blur_in blur_in)
 	: game_menu_state{std::move(subsystems), SELECTION_TREE, SHORTCUTS, std::move(game), std::move(savefile), update_game::YES}
 	, m_substate{blur_in == blur_in::YES ? substate::BLURRING_IN : substate::GAME_OVER}
 {
@@ -126,7 +127,7 @@ bool game_over_state::transparent_cursor() const
 
 tr::next_state game_over_state::tick()
 {
-	const best_results& best_results{m_savefile.best_results(m_game->gamemode())};
+	const best_results& best_results{m_savefile->best_results(m_game->gamemode())};
 
 	game_menu_state::tick();
 	switch (m_substate) {
@@ -204,7 +205,7 @@ float game_over_state::blur_strength()
 
 text_command game_over_state::best_time_text() const
 {
-	const ticks best_time{m_savefile.best_results(m_game->gamemode()).time};
+	const ticks best_time{m_savefile->best_results(m_game->gamemode()).time};
 
 	if (best_time < m_game->final_time()) {
 		return localized_text{m_subsystems->localization, "new_personal_best"};
@@ -216,7 +217,7 @@ text_command game_over_state::best_time_text() const
 
 text_command game_over_state::best_score_text() const
 {
-	const i64 best_score{m_savefile.best_results(m_game->gamemode()).score};
+	const i64 best_score{m_savefile->best_results(m_game->gamemode()).score};
 
 	if (best_score < m_game->final_score()) {
 		return localized_text{m_subsystems->localization, "new_personal_best"};
@@ -259,8 +260,7 @@ void game_over_state::on_restart()
 
 	m_elapsed = 0;
 	m_substate = substate::RESTARTING;
-	m_savefile.add_score(m_game->gamemode(), score);
-	m_savefile.save_to_file();
+	m_savefile = m_subsystems->savefile_service.add_score(m_game->gamemode(), score);
 	set_up_exit_animation();
 	m_next_state =
 		make_game_state_async<active_game>(m_subsystems, regular_game_data{}, m_subsystems->input, m_savefile, m_game->gamemode());
@@ -281,8 +281,7 @@ void game_over_state::on_exit()
 
 	m_elapsed = 0;
 	m_substate = substate::QUITTING;
-	m_savefile.add_score(m_game->gamemode(), score);
-	m_savefile.save_to_file();
+	m_savefile = m_subsystems->savefile_service.add_score(m_game->gamemode(), score);
 	set_up_exit_animation();
 	m_next_state = make_async<title_state>();
 }
\ No newline at end of file
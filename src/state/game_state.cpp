@@ -12,8 +12,12 @@
 //////////////////////////////////////////////////////////////// CONSTANTS ////////////////////////////////////////////////////////////////
 
 constexpr tag T_REPLAY{"replay"};
+constexpr tag T_REPLAY_DESYNC{"replay_desync"};
 constexpr tag T_INDICATOR{"indicator"};
 
+// Amount of time the left and right arrow keys seek by during replay playback.
+constexpr ticks REPLAY_SEEK_STEP{5_s};
+
 //////////////////////////////////////////////////////////////// GAME STATE ///////////////////////////////////////////////////////////////
 
 game_state::game_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, game_state_data data, fade_in fade_in)
@@ -31,6 +35,17 @@ game_state::game_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<g
 			.unhide_time =  0,
 			.text = localized_text{m_subsystems->localization, T_REPLAY}
 		});
+		m_ui.emplace<label_widget>(T_REPLAY_DESYNC, {
+			.animation = {{4, 950}},
+			.alignment = tr::align::BOTTOM_LEFT,
+			.unhide_time = DONT_UNHIDE,
+			.text = [this] {
+				const ticks time{ticks(m_shown_desync.value_or(0))};
+				return TR_FMT::format("{} {}", m_subsystems->localization[T_REPLAY_DESYNC], format_time_long(time));
+			},
+			.font_size = 32,
+			.color = "FF8080A0"_rgba8
+		});
 		m_ui.emplace<replay_playback_indicator_widget>(T_INDICATOR, {
 			.input = m_subsystems->input,
 			.localization = m_subsystems->localization,
@@ -40,6 +55,10 @@ game_state::game_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<g
 		});
 	}
 	// clang-format on
+
+	if (m_substate == substate::ONGOING) {
+		m_game_thread.emplace(m_game);
+	}
 }
 
 //
@@ -49,6 +68,11 @@ bool game_state::transparent_cursor() const
 	return true;
 }
 
+bool game_state::interpolates_frames() const
+{
+	return m_game_thread.has_value();
+}
+
 tr::next_state game_state::handle_event(const tr::sys::event& event)
 {
 	if (event.is<tr::sys::quit_event>()) {
@@ -60,7 +84,25 @@ tr::next_state game_state::handle_event(const tr::sys::event& event)
 	if (m_substate != substate::FADING_IN && event.is<tr::sys::key_down_event>() && event.as<tr::sys::key_down_event>().key == "Escape"_k) {
 		audio::instance().play_sound(sound::PAUSE, 0.8f, 0.0f);
 		audio::instance().pause_song();
-		return std::make_unique<pause_state>(m_subsystems, m_game, savefile{}, m_data, m_subsystems->input.mouse_pos, blur_in::YES);
+		m_game_thread.reset();
+		return std::make_unique<pause_state>(m_subsystems, m_game, m_subsystems->savefile_service.snapshot(), m_data,
+											 m_subsystems->input.mouse_pos, blur_in::YES);
+	}
+	else if (m_substate == substate::ONGOING && std::holds_alternative<replay_game_data>(m_data) && event.is<tr::sys::key_down_event>()) {
+		replay_game& game{(replay_game&)*m_game};
+		const tr::sys::key_down_event& key_down{event.as<tr::sys::key_down_event>()};
+		if (key_down.key == "Left"_k || key_down.key == "Right"_k) {
+			// The simulation has to be stopped while the game is seeked.
+			m_game_thread.reset();
+			if (key_down.key == "Left"_k) {
+				game.seek(game.position() - std::min(game.position(), usize{REPLAY_SEEK_STEP}));
+			}
+			else {
+				game.seek(game.position() + REPLAY_SEEK_STEP);
+			}
+			m_game_thread.emplace(m_game);
+		}
+		return tr::KEEP_STATE;
 	}
 	else {
 		return tr::KEEP_STATE;
@@ -77,36 +119,35 @@ tr::next_state game_state::tick()
 			m_elapsed = 0;
 			audio::instance().play_song(m_game->gamemode().song, 0.1s);
 			audio::instance().play_sound(sound::BALL_SPAWN, 0.25f, 0);
+			m_game_thread.emplace(m_game);
 		}
 		return tr::KEEP_STATE;
 	case substate::ONGOING:
+		m_game_thread->set_mouse_pos(m_subsystems->input.mouse_pos);
+		m_game_thread->dispatch_events(live_event_sink::instance());
+		m_game_thread->update();
 		if (std::holds_alternative<replay_game_data>(m_data)) {
+			show_replay_desync_if_needed();
 			if (m_subsystems->input.held(tr::sys::keymod::SHIFT)) {
-				if (m_elapsed % 4 == 0) {
-					m_game->tick();
-				}
+				m_game_thread->set_speed(0.25f);
 				set_song_speed_if_needed(0.25f);
 			}
 			else if (m_subsystems->input.held(tr::sys::keymod::CTRL)) {
-				for (int i = 0; i < 4; ++i) {
-					m_game->tick();
-					if (((replay_game&)*m_game).done()) {
-						break;
-					}
-				}
+				m_game_thread->set_speed(4.0f);
 				set_song_speed_if_needed(4.0f);
 			}
 			else {
-				m_game->tick();
+				m_game_thread->set_speed(1.0f);
 				set_song_speed_if_needed(1.0f);
 			}
 
-			if (((replay_game&)*m_game).done()) {
-				if (m_game->game_over()) {
+			if (m_game_thread->replay_done()) {
+				if (m_game_thread->frame().game_over()) {
 					m_substate = substate::GAME_OVER;
 				}
 				else {
 					m_substate = substate::EXITING;
+					m_game_thread.reset();
 					m_next_state = make_async<replays_state>(m_subsystems);
 				}
 				audio::instance().fade_song_out(0.5s);
@@ -120,24 +161,27 @@ tr::next_state game_state::tick()
 			}
 		}
 		else {
-			m_game->tick();
-			if (m_game->game_over()) {
+			if (m_game_thread->frame().game_over()) {
 				m_substate = substate::GAME_OVER;
 				m_elapsed = 0;
 				audio::instance().fade_song_out(0.5s);
-				if (std::holds_alternative<regular_game_data>(m_data)) {
-					m_next_state = make_async<game_over_state>(m_subsystems, m_game, savefile{}, blur_in::YES);
-				}
 			}
 		}
 		return tr::KEEP_STATE;
 	case substate::GAME_OVER:
-		m_game->tick();
+		if (!m_game_thread.has_value()) {
+			// Waiting for the game over state, which is only created once the simulation no longer touches the game.
+			return next_state_if_after(0.75_s);
+		}
+		m_game_thread->dispatch_events(live_event_sink::instance());
+		m_game_thread->update();
 		if (m_elapsed >= 0.75_s) {
+			m_game_thread.reset();
 			renderer::instance().set_default_transform(TRANSFORM);
 			switch (m_data.index()) {
 			case tr::type_index<regular_game_data, game_state_data>:
-				return m_next_state.get();
+				m_next_state = make_async<game_over_state>(m_subsystems, m_game, m_subsystems->savefile_service.snapshot(), blur_in::YES);
+				return next_state_if_after(0.75_s);
 			case tr::type_index<test_game_data, game_state_data>:
 				m_substate = substate::EXITING;
 				m_elapsed = 0;
@@ -163,10 +207,20 @@ tr::next_state game_state::tick()
 
 void game_state::draw()
 {
-	m_game->add_to_renderer(renderer::instance());
+	const float primary_hue{float(m_subsystems->settings.primary_hue)};
+	const float secondary_hue{float(m_subsystems->settings.secondary_hue)};
+	// While the game is being simulated, the latest frame published by the simulation thread is drawn instead of the game itself.
+	if (m_game_thread.has_value()) {
+		m_game_thread->update();
+		m_game_thread->frame().add_to_renderer(renderer::instance(), primary_hue, secondary_hue, m_game_thread->interpolation_factor());
+	}
+	else {
+		m_game->add_to_renderer(renderer::instance(), primary_hue, secondary_hue);
+	}
 	if (std::holds_alternative<replay_game_data>(m_data)) {
 		m_ui.add_to_renderer(renderer::instance(), m_subsystems->input.mouse_pos);
-		add_replay_cursor_to_renderer(((replay_game&)*m_game).cursor_pos());
+		add_replay_cursor_to_renderer(m_game_thread.has_value() ? m_game_thread->replay_cursor_pos()
+																: ((replay_game&)*m_game).cursor_pos());
 	}
 	renderer::instance().add_fade_overlay(fade_overlay_opacity());
 	renderer::instance().draw_layers(renderer::instance().screen());
@@ -187,6 +241,15 @@ float game_state::fade_overlay_opacity() const
 	}
 }
 
+void game_state::show_replay_desync_if_needed()
+{
+	const std::optional<usize> first_desync{m_game_thread->replay_first_desync()};
+	if (first_desync.has_value() && first_desync != m_shown_desync) {
+		m_shown_desync = first_desync;
+		m_ui[T_REPLAY_DESYNC].unhide(0.25_s);
+	}
+}
+
 void game_state::set_song_speed_if_needed(float speed)
 {
 	if (m_song_speed != speed) {
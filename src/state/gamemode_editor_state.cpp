@@ -50,11 +50,6 @@ constexpr shortcut_table SHORTCUTS{
 // clang-format on
 /////////////////////////////////////////////////////////// GAMEMODE EDITOR TYPE //////////////////////////////////////////////////////////
 
-new_gamemode_editor::new_gamemode_editor(savefile savefile)
-	: m_savefile{std::move(savefile)}
-{
-}
-
 localized_text new_gamemode_editor::subtitle_text(const localization& localization) const
 {
 	return localized_text{localization, "new_gamemode"};
@@ -62,8 +57,7 @@ localized_text new_gamemode_editor::subtitle_text(const localization& localizati
 
 void new_gamemode_editor::on_save(gamemode_editor_state& state)
 {
-	m_savefile.gamemode_draft = gamemode{};
-	m_savefile.save_to_file();
+	state.m_subsystems->savefile_service.modify([](savefile& savefile) { savefile.gamemode_draft = gamemode{}; });
 	state.m_pending.save_to_directory();
 	state.m_next_state = make_async<title_state>(state.m_subsystems, state.m_game);
 	state.set_up_exit_animation(animate_title::YES, animate_subtitle::YES);
@@ -71,8 +65,7 @@ void new_gamemode_editor::on_save(gamemode_editor_state& state)
 
 void new_gamemode_editor::on_discard(gamemode_editor_state& state)
 {
-	m_savefile.gamemode_draft = state.m_pending;
-	m_savefile.save_to_file();
+	state.m_subsystems->savefile_service.modify([&](savefile& savefile) { savefile.gamemode_draft = state.m_pending; });
 	state.m_next_state = make_async<gamemode_manager_state>(state.m_subsystems, state.m_game, animate_title::NO);
 	state.set_up_exit_animation(animate_title::NO, animate_subtitle::YES);
 }
@@ -348,7 +341,8 @@ void gamemode_editor_state::on_test()
 	m_pending.description = m_ui.as<line_input_widget<40>>(T_DESCRIPTION).contents();
 	set_up_exit_animation(animate_title::YES, animate_subtitle::YES);
 	audio::instance().fade_song_out(0.5s);
-	m_next_state = make_game_state_async<active_game>(m_subsystems, test_game_data{m_type}, m_subsystems->input, savefile{}, m_pending);
+	m_next_state = make_game_state_async<active_game>(m_subsystems, test_game_data{m_type}, m_subsystems->input,
+													  m_subsystems->savefile_service.snapshot(), m_pending);
 }
 
 void gamemode_editor_state::on_save()
@@ -118,12 +118,12 @@ void gamemode_manager_state::set_up_exit_animation(animate_title animate_title)
 
 void gamemode_manager_state::on_enter_new_gamemode()
 {
-	savefile savefile;
+	const savefile_snapshot savefile{m_subsystems->savefile_service.snapshot()};
 
 	m_substate = substate::EXITING;
 	m_elapsed = 0;
 	set_up_exit_animation(animate_title::NO);
-	m_next_state = make_async<gamemode_editor_state>(m_subsystems, m_game, new_gamemode_editor{savefile}, savefile.gamemode_draft,
+	m_next_state = make_async<gamemode_editor_state>(m_subsystems, m_game, new_gamemode_editor{}, savefile->gamemode_draft,
 													 animate_subtitle::YES);
 }
 
@@ -132,8 +132,8 @@ void gamemode_manager_state::on_enter_edit_gamemode()
 	m_substate = substate::EXITING;
 	m_elapsed = 0;
 	set_up_exit_animation(animate_title::NO);
-	m_next_state =
-		make_async<gamemode_selector_state>(m_subsystems, m_game, edit_gamemode_selector{savefile{}.name()}, animate_subtitle::YES);
+	const edit_gamemode_selector selector{m_subsystems->savefile_service.snapshot()->name()};
+	m_next_state = make_async<gamemode_selector_state>(m_subsystems, m_game, selector, animate_subtitle::YES);
 }
 
 void gamemode_manager_state::on_enter_clone_gamemode()
@@ -141,8 +141,8 @@ void gamemode_manager_state::on_enter_clone_gamemode()
 	m_substate = substate::EXITING;
 	m_elapsed = 0;
 	set_up_exit_animation(animate_title::NO);
-	m_next_state =
-		make_async<gamemode_selector_state>(m_subsystems, m_game, clone_gamemode_selector{savefile{}.name()}, animate_subtitle::YES);
+	const clone_gamemode_selector selector{m_subsystems->savefile_service.snapshot()->name()};
+	m_next_state = make_async<gamemode_selector_state>(m_subsystems, m_game, selector, animate_subtitle::YES);
 }
 
 void gamemode_manager_state::on_enter_delete_gamemode()
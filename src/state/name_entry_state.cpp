@@ -98,9 +98,7 @@ void name_entry_state::on_exit()
 		m_ui[T_INPUT].hide(1.0_s);
 		m_ui[T_CONFIRM].move_and_hide(BOTTOM_START_POS, 1.0_s);
 
-		savefile savefile;
-		savefile.rename(name);
-		savefile.save_to_file();
+		m_subsystems->savefile_service.modify([&](savefile& savefile) { savefile.rename(name); });
 
 		m_next_state = make_async<title_state>(m_subsystems, m_game);
 	}
@@ -58,8 +58,8 @@ constexpr shortcut_table SHORTCUTS_SPECIAL{
 // clang-format on
 /////////////////////////////////////////////////////////////// PAUSE STATE ///////////////////////////////////////////////////////////////
 
-pause_state::pause_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile, game_state_data data,
-						 glm::vec2 mouse_pos, blur_in blur_in)
+pause_state::pause_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
+						 game_state_data data, glm::vec2 mouse_pos, blur_in blur_in)
 	: game_menu_state{std::move(subsystems),
 					  std::holds_alternative<regular_game_data>(m_data) ? SELECTION_TREE_REGULAR : SELECTION_TREE_SPECIAL,
 					  std::holds_alternative<regular_game_data>(m_data) ? SHORTCUTS_REGULAR : SHORTCUTS_SPECIAL,
@@ -71,7 +71,9 @@ pause_state::pause_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr
 	, m_start_mouse_pos{mouse_pos}
 {
 	if (blur_in == blur_in::YES) {
-		m_game->add_to_renderer(renderer::instance());
+		const float primary_hue{float(m_subsystems->settings.primary_hue)};
+		const float secondary_hue{float(m_subsystems->settings.secondary_hue)};
+		m_game->add_to_renderer(renderer::instance(), primary_hue, secondary_hue, 1);
 		renderer::instance().draw_layers(renderer::instance().blur_input());
 	}
 
@@ -292,8 +294,7 @@ void pause_state::on_restart()
 	if (std::holds_alternative<regular_game_data>(m_data)) {
 		const score_flags score_flags{true, debug_settings::instance().modified_game_speed()};
 		const score_entry score{{}, current_timestamp(), m_game->final_score(), m_game->final_time(), score_flags};
-		m_savefile.add_score(m_game->gamemode(), score);
-		m_savefile.save_to_file();
+		m_savefile = m_subsystems->savefile_service.add_score(m_game->gamemode(), score);
 		m_next_state = make_game_state_async<active_game>(m_subsystems, m_data, m_subsystems->input, m_savefile, m_game->gamemode());
 	}
 	else if (std::holds_alternative<replay_game_data>(m_data)) {
@@ -320,8 +321,7 @@ void pause_state::on_quit()
 	if (std::holds_alternative<regular_game_data>(m_data)) {
 		const score_flags score_flags{true, debug_settings::instance().modified_game_speed()};
 		const score_entry score{{}, current_timestamp(), m_game->final_score(), m_game->final_time(), score_flags};
-		m_savefile.add_score(m_game->gamemode(), score);
-		m_savefile.save_to_file();
+		m_savefile = m_subsystems->savefile_service.add_score(m_game->gamemode(), score);
 		m_next_state = make_async<title_state>();
 	}
 	else if (std::holds_alternative<replay_game_data>(m_data)) {
@@ -35,7 +35,7 @@ constexpr shortcut_table SHORTCUTS{
 // clang-format on
 //////////////////////////////////////////////////////////// SAVE REPLAY STATE ////////////////////////////////////////////////////////////
 
-save_replay_state::save_replay_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile,
+save_replay_state::save_replay_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
 									 save_screen_flags flags)
 	: game_menu_state{std::move(subsystems), SELECTION_TREE,      SHORTCUTS,
 					  std::move(game),       std::move(savefile), update_game(bool(flags & save_screen_flags::GAME_OVER))}
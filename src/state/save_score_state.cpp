@@ -37,7 +37,7 @@ constexpr shortcut_table SHORTCUTS{
 // clang-format on
 //////////////////////////////////////////////////////////// SAVE SCORE STATE /////////////////////////////////////////////////////////////
 
-save_score_state::save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile,
+save_score_state::save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
 								   glm::vec2 mouse_pos, save_screen_flags flags)
 	: game_menu_state{std::move(subsystems), SELECTION_TREE, SHORTCUTS, std::move(game), std::move(savefile), update_game::NO}
 	, m_substate{substate_base::SAVING_SCORE | flags}
@@ -53,7 +53,7 @@ save_score_state::save_score_state(std::shared_ptr<subsystems> subsystems, std::
 	set_up_ui();
 }
 
-save_score_state::save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile savefile,
+save_score_state::save_score_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<game> game, savefile_snapshot savefile,
 								   save_screen_flags flags)
 	: game_menu_state{std::move(subsystems), SELECTION_TREE, SHORTCUTS, std::move(game), std::move(savefile), update_game::YES}
 	, m_substate{substate_base::SAVING_SCORE | (flags | save_screen_flags::GAME_OVER)}
@@ -190,8 +190,7 @@ void save_score_state::on_save()
 	m_substate = substate_base::RETURNING_OR_ENTERING_SAVE_REPLAY | to_flags(m_substate);
 	m_elapsed = 0;
 	set_up_exit_animation();
-	m_savefile.add_score(m_game->gamemode(), m_score);
-	m_savefile.save_to_file();
+	m_savefile = m_subsystems->savefile_service.add_score(m_game->gamemode(), m_score);
 	m_next_state = make_async<save_replay_state>(m_subsystems, m_game, m_savefile, to_flags(m_substate));
 }
 
@@ -34,7 +34,7 @@ constexpr shortcut_table SHORTCUTS{
 //////////////////////////////////////////////////////// SCOREBOARD SELECTION STATE ///////////////////////////////////////////////////////
 
 scoreboard_selection_state::scoreboard_selection_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game,
-													   savefile savefile, animate_title animate_title)
+													   savefile_snapshot savefile, animate_title animate_title)
 	: main_menu_state{std::move(subsystems), SELECTION_TREE, SHORTCUTS, std::move(game)}
 	, m_substate{substate::IN_SCOREBOARD_SELECTION}
 	, m_savefile{std::move(savefile)}
@@ -51,7 +51,7 @@ scoreboard_selection_state::scoreboard_selection_state(std::shared_ptr<subsystem
 		.animation = bool(animate_title) ? tweened_position{TOP_START_POS, {500, 64}, 0.5_s} : tweened_position{{500, 64}},
 		.alignment = tr::align::TOP_CENTER,
 		.unhide_time = bool(animate_title) ? 0.5_s : 0_s,
-		.text = constant_text{m_savefile.format_info(m_subsystems->localization)},
+		.text = constant_text{m_savefile->format_info(m_subsystems->localization)},
 		.font_size = 32
 	});
 	m_ui.emplace<text_button_widget>(T_EXIT, {
@@ -52,7 +52,7 @@ constexpr shortcut_table SHORTCUTS{
 // clang-format on
 ///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
 
-// Creates a set of widgets for a new page of scores.
+// Creates a set of widgets for a new page of scores (only the scores on the page are passed in).
 static std::unordered_map<tag, std::unique_ptr<widget>> prepare_next_widgets(const localization& localization, enum score_widget::type type,
 																			 const std::vector<score_entry>& scores, int page)
 {
@@ -66,7 +66,7 @@ static std::unordered_map<tag, std::unique_ptr<widget>> prepare_next_widgets(con
 			.unhide_time = 0.25_s,
 			.type = type,
 			.rank = rank,
-			.score = rank <= scores.size() ? tr::opt_ref{scores[rank - 1]} : std::nullopt
+			.score = i < scores.size() ? tr::opt_ref{scores[i]} : std::nullopt
 		}));
 		// clang-format on
 	}
@@ -75,18 +75,17 @@ static std::unordered_map<tag, std::unique_ptr<widget>> prepare_next_widgets(con
 
 ///////////////////////////////////////////////////////////// SCOREBOARD STATE ////////////////////////////////////////////////////////////
 
-scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game, savefile savefile,
-								   scoreboard scoreboard)
+scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::shared_ptr<playerless_game> game,
+								   savefile_snapshot savefile, scoreboard scoreboard)
 	: main_menu_state{std::move(subsystems), SELECTION_TREE, SHORTCUTS, std::move(game)}
 	, m_substate{substate::IN_SCOREBOARD}
 	, m_scoreboard{scoreboard}
 	, m_page{0}
 	, m_savefile{std::move(savefile)}
-	, m_selected{m_savefile.score_categories().begin()}
+	, m_selected{m_savefile->score_categories().begin()}
 {
-	if (!m_savefile.score_categories().empty()) {
-		m_sorted_scores = m_selected->entries;
-		std::ranges::sort(m_sorted_scores, scoreboard == scoreboard::SCORE ? compare_scores : compare_times);
+	if (!m_savefile->score_categories().empty()) {
+		rank_scores();
 	}
 
 	// clang-format off
@@ -101,7 +100,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.animation = {{500, 64}},
 		.alignment = tr::align::TOP_CENTER,
 		.unhide_time = 0_s,
-		.text = constant_text{m_savefile.format_info(m_subsystems->localization)},
+		.text = constant_text{m_savefile->format_info(m_subsystems->localization)},
 		.font_size = 32
 	});
 	m_ui.emplace<text_button_widget>(T_EXIT, {
@@ -114,7 +113,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.action_sound = sound::CANCEL
 	});
 
-	if (m_savefile.score_categories().empty()) {
+	if (m_savefile->score_categories().empty()) {
 		m_ui.emplace<label_widget>(T_NO_SCORES_FOUND, {
 			.animation = {{600, 500}, {500, 500}, 0.5_s},
 			.text = localized_text{m_subsystems->localization, T_NO_SCORES_FOUND},
@@ -124,13 +123,14 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		return;
 	}
 
+	const std::vector<score_entry> scores{load_page()};
 	for (usize i = 0; i < SCORES_PER_PAGE; ++i) {
 		m_ui.emplace<score_widget>(SCORE_TAGS[i], {
 			.localization = m_subsystems->localization,
 			.animation = {{i % 2 == 0 ? 400 : 600, 173 + 86 * i}, {500, 173 + 86 * i}, 0.5_s},
 			.type = (enum score_widget::type)(m_scoreboard),
 			.rank = m_page * SCORES_PER_PAGE + i + 1,
-			.score = m_sorted_scores.size() > i ? tr::opt_ref{m_sorted_scores[i]} : std::nullopt
+			.score = scores.size() > i ? tr::opt_ref{scores[i]} : std::nullopt
 		});
 	}
 
@@ -138,7 +138,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.animation = {{-50, 892.5}, {10, 892.5}, 0.5_s},
 		.alignment = tr::valign::BOTTOM,
 		.type = arrow_type::LEFT,
-		.status = [this] { return m_substate == substate::IN_SCOREBOARD && m_savefile.score_categories().size() > 1; },
+		.status = [this] { return m_substate == substate::IN_SCOREBOARD && m_savefile->score_categories().size() > 1; },
 		.action = [this] { on_gamemode_decrement(); }
 	});
 	m_ui.emplace<label_widget>(T_GAMEMODE_C, {
@@ -151,7 +151,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.animation = {{1050, 892.5}, {990, 892.5}, 0.5_s},
 		.alignment = tr::valign::BOTTOM,
 		.type = arrow_type::RIGHT,
-		.status = [this] { return m_substate == substate::IN_SCOREBOARD && m_savefile.score_categories().size() > 1; },
+		.status = [this] { return m_substate == substate::IN_SCOREBOARD && m_savefile->score_categories().size() > 1; },
 		.action = [this] { on_gamemode_increment(); }
 	});
 	m_ui.emplace<arrow_widget>(T_PAGE_D, {
@@ -165,7 +165,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.animation = {BOTTOM_START_POS, {500, 950}, 0.5_s},
 		.alignment = tr::align::BOTTOM_CENTER,
 		.text = [this] {
-			const int total{std::max(int(m_selected->entries.size()) - 1, 0) / SCORES_PER_PAGE + 1};
+			const int total{std::max(int(m_selected->size()) - 1, 0) / SCORES_PER_PAGE + 1};
 			return TR_FMT::format("{}/{}", m_page + 1, total);
 		}
 	});
@@ -174,7 +174,7 @@ scoreboard_state::scoreboard_state(std::shared_ptr<subsystems> subsystems, std::
 		.alignment = tr::valign::BOTTOM,
 		.type = arrow_type::RIGHT,
 		.status = [this] {
-			const int last_page{std::max(int(m_selected->entries.size()) - 1, 0) / SCORES_PER_PAGE};
+			const int last_page{std::max(int(m_selected->size()) - 1, 0) / SCORES_PER_PAGE};
 			return m_substate == substate::IN_SCOREBOARD && m_page < last_page;
 		},
 		.action = [this] { on_page_increment(); }
@@ -206,20 +206,35 @@ tr::next_state scoreboard_state::tick()
 
 ///////////////////////////////////////////////////////////////// HELPERS /////////////////////////////////////////////////////////////////
 
+void scoreboard_state::rank_scores()
+{
+	m_ranking = m_scoreboard == scoreboard::SCORE ? m_selected->ranked_by_score() : m_selected->ranked_by_time();
+}
+
+std::vector<score_entry> scoreboard_state::load_page() const
+{
+	// Only the entries on the page are fully loaded from the savefile.
+	std::vector<score_entry> scores;
+	for (usize i = m_page * SCORES_PER_PAGE; i < std::min(usize(m_page + 1) * SCORES_PER_PAGE, m_ranking.size()); ++i) {
+		scores.push_back((*m_selected)[m_ranking[i]]);
+	}
+	return scores;
+}
+
+//
+
 void scoreboard_state::set_up_page_switch_animation()
 {
 	for (usize i = 0; i < SCORES_PER_PAGE; i++) {
 		m_ui[SCORE_TAGS[i]].move_x_and_hide(i % 2 == 0 ? 600 : 400, 0.25_s);
 	}
-	m_sorted_scores = m_selected->entries;
-	std::ranges::sort(m_sorted_scores, m_scoreboard == scoreboard::SCORE ? compare_scores : compare_times);
 	m_next_widgets = std::async(std::launch::async, prepare_next_widgets, m_subsystems->localization,
-								(enum score_widget::type)(m_scoreboard), m_sorted_scores, m_page);
+								(enum score_widget::type)(m_scoreboard), load_page(), m_page);
 }
 
 void scoreboard_state::set_up_exit_animation()
 {
-	if (m_savefile.score_categories().empty()) {
+	if (m_savefile->score_categories().empty()) {
 		m_ui[T_NO_SCORES_FOUND].move_x_and_hide(400, 0.5_s);
 	}
 	else {
@@ -250,10 +265,11 @@ void scoreboard_state::on_gamemode_decrement()
 	m_substate = substate::SWITCHING_PAGE;
 	m_elapsed = 0;
 	m_page = 0;
-	if (m_selected == m_savefile.score_categories().begin()) {
-		m_selected = m_savefile.score_categories().end();
+	if (m_selected == m_savefile->score_categories().begin()) {
+		m_selected = m_savefile->score_categories().end();
 	}
 	--m_selected;
+	rank_scores();
 	set_up_page_switch_animation();
 }
 
@@ -262,9 +278,10 @@ void scoreboard_state::on_gamemode_increment()
 	m_substate = substate::SWITCHING_PAGE;
 	m_elapsed = 0;
 	m_page = 0;
-	if (++m_selected == m_savefile.score_categories().end()) {
-		m_selected = m_savefile.score_categories().begin();
+	if (++m_selected == m_savefile->score_categories().end()) {
+		m_selected = m_savefile->score_categories().begin();
 	}
+	rank_scores();
 	set_up_page_switch_animation();
 }
 
@@ -21,6 +21,8 @@ constexpr tag T_WINDOW_SIZE_C{"window_size_c"};
 constexpr tag T_WINDOW_SIZE_I{"window_size_i"};
 constexpr tag T_VSYNC{"vsync"};
 constexpr tag T_VSYNC_C{"vsync_c"};
+constexpr tag T_BLUR_QUALITY{"blur_quality"};
+constexpr tag T_BLUR_QUALITY_C{"blur_quality_c"};
 constexpr tag T_MOUSE_SENSITIVITY{"mouse_sensitivity"};
 constexpr tag T_MOUSE_SENSITIVITY_D{"mouse_sensitivity_d"};
 constexpr tag T_MOUSE_SENSITIVITY_C{"mouse_sensitivity_c"};
@@ -57,6 +59,7 @@ constexpr std::array LABELS{
 	label_info{T_DISPLAY_MODE, "display_mode_tt"},
 	label_info{T_WINDOW_SIZE, "window_size_tt"},
 	label_info{T_VSYNC, "vsync_tt"},
+	label_info{T_BLUR_QUALITY, "blur_quality_tt"},
 	label_info{T_MOUSE_SENSITIVITY, "mouse_sensitivity_tt"},
 	label_info{T_PLAYER_SKIN, "player_skin_tt"},
 	label_info{T_PRIMARY_HUE, "primary_hue_tt"},
@@ -71,6 +74,7 @@ constexpr std::array RIGHT_WIDGETS{
 	T_DISPLAY_MODE_C,
 	T_WINDOW_SIZE_D, T_WINDOW_SIZE_C, T_WINDOW_SIZE_I,
 	T_VSYNC_C,
+	T_BLUR_QUALITY_C,
 	T_MOUSE_SENSITIVITY_D, T_MOUSE_SENSITIVITY_C, T_MOUSE_SENSITIVITY_I,
 	T_PLAYER_SKIN_C, T_PLAYER_SKIN_PREVIEW,
 	T_PRIMARY_HUE_D, T_PRIMARY_HUE_C, T_PRIMARY_HUE_I, T_PRIMARY_HUE_PREVIEW,
@@ -88,6 +92,7 @@ constexpr selection_tree SELECTION_TREE{
 	selection_tree_row{T_DISPLAY_MODE_C},
 	selection_tree_row{T_WINDOW_SIZE_D, T_WINDOW_SIZE_C, T_WINDOW_SIZE_I},
 	selection_tree_row{T_VSYNC_C},
+	selection_tree_row{T_BLUR_QUALITY_C},
 	selection_tree_row{T_MOUSE_SENSITIVITY_D, T_MOUSE_SENSITIVITY_C, T_MOUSE_SENSITIVITY_I},
 	selection_tree_row{T_PLAYER_SKIN_C},
 	selection_tree_row{T_PRIMARY_HUE_D, T_PRIMARY_HUE_C, T_PRIMARY_HUE_I},
@@ -111,23 +116,25 @@ constexpr shortcut_table SHORTCUTS{
 // Starting position for display mode right widgets.
 constexpr glm::vec2 DISPLAY_MODE_START_POS{1050, 121};
 // Starting position for window size right widgets.
-constexpr glm::vec2 WINDOW_SIZE_START_POS{1050, DISPLAY_MODE_START_POS.y + 75};
+constexpr glm::vec2 WINDOW_SIZE_START_POS{1050, DISPLAY_MODE_START_POS.y + 70};
 // Starting position for V-sync right widgets.
-constexpr glm::vec2 VSYNC_START_POS{1050, WINDOW_SIZE_START_POS.y + 75};
+constexpr glm::vec2 VSYNC_START_POS{1050, WINDOW_SIZE_START_POS.y + 70};
+// Starting position for blur quality right widgets.
+constexpr glm::vec2 BLUR_QUALITY_START_POS{1050, VSYNC_START_POS.y + 70};
 // Starting position for mouse sensitivity right widgets.
-constexpr glm::vec2 MOUSE_SENSITIVITY_START_POS{1050, VSYNC_START_POS.y + 75};
+constexpr glm::vec2 MOUSE_SENSITIVITY_START_POS{1050, BLUR_QUALITY_START_POS.y + 70};
 // Starting position for player skin right widgets.
-constexpr glm::vec2 PLAYER_SKIN_START_POS{1050, MOUSE_SENSITIVITY_START_POS.y + 75};
+constexpr glm::vec2 PLAYER_SKIN_START_POS{1050, MOUSE_SENSITIVITY_START_POS.y + 70};
 // Starting position for primary hue right widgets.
-constexpr glm::vec2 PRIMARY_HUE_START_POS{1050, PLAYER_SKIN_START_POS.y + 75};
+constexpr glm::vec2 PRIMARY_HUE_START_POS{1050, PLAYER_SKIN_START_POS.y + 70};
 // Starting position for secondary hue right widgets.
-constexpr glm::vec2 SECONDARY_HUE_START_POS{1050, PRIMARY_HUE_START_POS.y + 75};
+constexpr glm::vec2 SECONDARY_HUE_START_POS{1050, PRIMARY_HUE_START_POS.y + 70};
 // Starting position for SFX volume right widgets.
-constexpr glm::vec2 SFX_VOLUME_START_POS{1050, SECONDARY_HUE_START_POS.y + 75};
+constexpr glm::vec2 SFX_VOLUME_START_POS{1050, SECONDARY_HUE_START_POS.y + 70};
 // Starting position for music volume right widgets.
-constexpr glm::vec2 MUSIC_VOLUME_START_POS{1050, SFX_VOLUME_START_POS.y + 75};
+constexpr glm::vec2 MUSIC_VOLUME_START_POS{1050, SFX_VOLUME_START_POS.y + 70};
 // Starting position for language right widgets.
-constexpr glm::vec2 LANGUAGE_START_POS{1050, MUSIC_VOLUME_START_POS.y + 75};
+constexpr glm::vec2 LANGUAGE_START_POS{1050, MUSIC_VOLUME_START_POS.y + 70};
 
 // clang-format on
 ///////////////////////////////////////////////////////////// INTERNAL HELPERS ////////////////////////////////////////////////////////////
@@ -169,7 +176,7 @@ settings_state::settings_state(std::shared_ptr<subsystems> subsystems, std::shar
 
 	for (usize i = 0; i < LABELS.size(); ++i) {
 		m_ui.emplace<label_widget>(LABELS[i].tag, {
-			.animation = {{-50, 121 + i * 75}, {15, 121 + i * 75}, 0.5_s},
+			.animation = {{-50, 121 + i * 70}, {15, 121 + i * 70}, 0.5_s},
 			.alignment = tr::align::CENTER_LEFT,
 			.tooltip_text = localized_text{m_subsystems->localization, LABELS[i].tooltip},
 			.text = localized_text{m_subsystems->localization, LABELS[i].tag},
@@ -220,6 +227,13 @@ settings_state::settings_state(std::shared_ptr<subsystems> subsystems, std::shar
 		.status = [this] { return m_substate != substate::EXITING; },
 		.action = [&vsync = m_pending.vsync] { vsync = !vsync; },
 	});
+	m_ui.emplace<text_button_widget>(T_BLUR_QUALITY_C, {
+		.animation = {BLUR_QUALITY_START_POS, {985, BLUR_QUALITY_START_POS.y}, 0.5_s},
+		.alignment = tr::align::CENTER_RIGHT,
+		.text = [this] { return std::string{m_subsystems->localization[m_pending.blur_quality == blur_quality::HIGH ? "high" : "low"]}; },
+		.status = [this] { return m_substate != substate::EXITING; },
+		.action = [&quality = m_pending.blur_quality] { quality = quality == blur_quality::HIGH ? blur_quality::LOW : blur_quality::HIGH; },
+	});
 	m_ui.emplace<arrow_widget>(T_MOUSE_SENSITIVITY_D, {
 		.animation = {MOUSE_SENSITIVITY_START_POS, {765, MOUSE_SENSITIVITY_START_POS.y}, 0.5_s},
 		.type = arrow_type::LEFT,
@@ -506,6 +520,9 @@ void settings_state::on_apply()
 	else if (m_pending.vsync != m_subsystems->settings.vsync) {
 		tr::sys::set_window_vsync(m_pending.vsync ? tr::sys::vsync::ADAPTIVE : tr::sys::vsync::DISABLED);
 	}
+	if (!restart_required && m_pending.blur_quality != m_subsystems->settings.blur_quality) {
+		renderer::instance().set_blur_quality(m_pending.blur_quality);
+	}
 	if (use_different_fonts) {
 		renderer::instance().text_engine.set_language_font();
 	}
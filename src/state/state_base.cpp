@@ -7,6 +7,26 @@
 #include "../../include/state/state_base.hpp"
 #include "../../include/renderer.hpp"
 
+///////////////////////////////////////////////////////////// LIVE EVENT SINK /////////////////////////////////////////////////////////////
+
+live_event_sink& live_event_sink::instance()
+{
+	static live_event_sink instance{};
+	return instance;
+}
+
+//
+
+void live_event_sink::play_sound(sound sound, float volume, float pan, float pitch)
+{
+	audio::instance().play_sound(sound, volume, pan, pitch);
+}
+
+void live_event_sink::shake_screen(glm::vec2 offset)
+{
+	renderer::instance().set_default_transform(tr::ortho(tr::frect2{offset, glm::vec2{1000}}));
+}
+
 ////////////////////////////////////////////////////////////////// STATE //////////////////////////////////////////////////////////////////
 
 state::subsystems::subsystems()
@@ -26,6 +46,11 @@ bool state::transparent_cursor() const
 	return false;
 }
 
+bool state::interpolates_frames() const
+{
+	return false;
+}
+
 tr::next_state state::handle_event(const tr::sys::event& event)
 {
 	if (event.is<tr::sys::quit_event>()) {
@@ -72,13 +97,14 @@ float main_menu_state::fade_overlay_opacity()
 tr::next_state main_menu_state::tick()
 {
 	state::tick();
-	m_game->tick();
+	m_game->tick(live_event_sink::instance());
 	return tr::KEEP_STATE;
 }
 
 void main_menu_state::draw()
 {
-	m_game->add_to_renderer(renderer::instance());
+	// The game is ticked on the main thread before every draw, so its latest state is drawn as-is.
+	m_game->add_to_renderer(renderer::instance(), float(m_subsystems->settings.secondary_hue), 1);
 	renderer::instance().add_menu_game_overlay();
 	m_ui.add_to_renderer(renderer::instance(), m_subsystems->input.mouse_pos);
 	renderer::instance().add_fade_overlay(fade_overlay_opacity());
@@ -88,7 +114,7 @@ void main_menu_state::draw()
 ///////////////////////////////////////////////////////////// GAME MENU STATE /////////////////////////////////////////////////////////////
 
 game_menu_state::game_menu_state(std::shared_ptr<subsystems> subsystems, selection_tree selection_tree, shortcut_table shortcuts,
-								 std::shared_ptr<game> game, savefile savefile, update_game update_game)
+								 std::shared_ptr<game> game, savefile_snapshot savefile, update_game update_game)
 	: state{std::move(subsystems), selection_tree, shortcuts}
 	, m_game{std::move(game)}
 	, m_savefile{std::move(savefile)}
@@ -100,7 +126,7 @@ tr::next_state game_menu_state::tick()
 {
 	state::tick();
 	if (m_update_game) {
-		m_game->tick();
+		m_game->tick(live_event_sink::instance());
 	}
 	return tr::KEEP_STATE;
 }
@@ -108,7 +134,10 @@ tr::next_state game_menu_state::tick()
 void game_menu_state::draw()
 {
 	if (m_update_game) {
-		m_game->add_to_renderer(renderer::instance());
+		// The game is ticked on the main thread before every draw, so its latest state is drawn as-is.
+		const float primary_hue{float(m_subsystems->settings.primary_hue)};
+		const float secondary_hue{float(m_subsystems->settings.secondary_hue)};
+		m_game->add_to_renderer(renderer::instance(), primary_hue, secondary_hue, 1);
 		renderer::instance().draw_layers(renderer::instance().blur_input());
 	}
 	renderer::instance().draw_blurred(saturation_factor(), blur_strength());
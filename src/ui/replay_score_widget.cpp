@@ -173,8 +173,9 @@ replay_widget::replay_widget(const properties& properties)
 					  m_parent_state.m_elapsed = 0;
 					  m_parent_state.set_up_exit_animation();
 					  audio::instance().fade_song_out(0.5s);
+					  const savefile_snapshot savefile{m_parent_state.m_subsystems->savefile_service.snapshot()};
 					  m_parent_state.m_next_state = make_game_state_async<replay_game>(m_parent_state.m_subsystems, replay_game_data{},
-																					   replay{(*m_replay_it)->first});
+																					   replay{(*m_replay_it)->first}, savefile);
 				  }
 			  },
 	  }}
@@ -7,14 +7,6 @@
 #include "../../include/renderer.hpp"
 #include "../../include/ui/widget.hpp"
 
-//////////////////////////////////////////////////////////// INTERNAL HELPERS /////////////////////////////////////////////////////////////
-
-// Determines whether the cache is too small to fit an image.
-static bool cache_too_small(const tr::gfx::texture& cache, const tr::bitmap& image)
-{
-	return cache.size().x < image.size().x || cache.size().y < image.size().y;
-}
-
 ////////////////////////////////////////////////////////////// TEXT COMMANDS //////////////////////////////////////////////////////////////
 
 std::string localized_text::operator()() const
@@ -129,17 +121,15 @@ text_widget::text_widget(tweened_position pos, tr::align alignment, ticks unhide
 	, m_max_width{max_width}
 	, m_text{text}
 	, m_last_text{text()}
-	, m_cache{renderer::instance().text_engine.render_text(
-		  ::text{
-			  m_last_text,
-			  renderer::instance().text_engine.determine_font(m_last_text, m_font),
-			  m_style,
-			  m_font_size,
-			  m_font_size / 12,
-			  float(m_max_width),
-		  },
-		  tr::halign::CENTER)}
-	, m_last_size{tr::get<tr::bitmap>(m_cache).size()}
+	, m_last_size{renderer::instance().text_engine.text_size(::text{
+					  m_last_text,
+					  renderer::instance().text_engine.determine_font(m_last_text, m_font),
+					  m_style,
+					  m_font_size,
+					  m_font_size / 12,
+					  float(m_max_width),
+				  }) *
+				  renderer::instance().scale()}
 {
 }
 
@@ -150,49 +140,28 @@ glm::vec2 text_widget::size() const
 
 void text_widget::release_graphical_resources()
 {
-	m_cache = std::monostate{};
+	m_layout.reset();
 }
 
 void text_widget::add_to_renderer_raw(renderer& renderer, tr::rgba8 tint)
 {
-	update_cache(renderer.text_engine);
+	update_layout(renderer);
 
 	tint.a *= opacity();
 
-	const tr::gfx::texture& texture{tr::get<tr::gfx::texture>(m_cache)};
-	const tr::gfx::simple_textured_mesh_ref quad{renderer.basic().new_textured_fan(layer::UI, 4, texture)};
-	tr::fill_rectangle_vertices(quad.positions, {tl(), text_widget::size()});
-	tr::fill_rectangle_vertices(quad.uvs, {{}, m_last_size / glm::vec2{texture.size()}});
-	std::ranges::fill(quad.tints, tint);
+	renderer.glyphs().add_to_renderer(renderer.basic(), layer::UI, *m_layout, tl(), 1 / renderer.scale(), tint);
 }
 
-void text_widget::update_cache(text_engine& text_engine) const
+void text_widget::update_layout(renderer& renderer) const
 {
 	std::string text_string{m_text()};
-	if (std::holds_alternative<std::monostate>(m_cache) || m_last_text != text_string) {
-		const font font{text_engine.determine_font(text_string, m_font)};
+	if (!m_layout.has_value() || !renderer.glyphs().valid(*m_layout) || m_last_text != text_string) {
+		const font font{renderer.text_engine.determine_font(text_string, m_font)};
 		const text text{text_string, font, m_style, m_font_size, m_font_size / 12, float(m_max_width)};
-		const tr::bitmap render{text_engine.render_text(text, tr::halign::CENTER)};
-		tr::gfx::texture* const cache_texture{std::get_if<tr::gfx::texture>(&m_cache)};
-		if (cache_texture == nullptr || cache_too_small(*cache_texture, render)) {
-			[[maybe_unused]] tr::gfx::texture& texture{m_cache.emplace<tr::gfx::texture>(render)};
-			TR_SET_LABEL(texture, TR_FMT::format("(Bodge) Widget texture"));
-		}
-		else {
-			cache_texture->clear({});
-			cache_texture->set_region({}, render);
-		}
-		m_last_size = render.size();
+		m_layout = renderer.glyphs().layout(renderer.text_engine, text, tr::halign::CENTER);
+		m_last_size = m_layout->size;
 		m_last_text = std::move(text_string);
 	}
-	else {
-		tr::bitmap* const cache_bitmap{std::get_if<tr::bitmap>(&m_cache)};
-		if (cache_bitmap != nullptr) {
-			const tr::bitmap source{std::move(*cache_bitmap)};
-			[[maybe_unused]] tr::gfx::texture& texture{m_cache.emplace<tr::gfx::texture>(source)};
-			TR_SET_LABEL(texture, TR_FMT::format("(Bodge) Widget texture"));
-		}
-	}
 }
 
 /////////////////////////////////////////////////////////// INTERVAL FORMATTER ////////////////////////////////////////////////////////////